@@ -0,0 +1,536 @@
+/**
+ * @file Benchmark.c
+ * @author Seb Madgwick
+ * @brief Measures the throughput of the data message encoders and of the
+ * decoder in messages per second, and the cost of the FIFO byte and block
+ * functions in cycles per byte. The inertial binary encoder is compared with
+ * a byte-wise encoder equivalent to the encoder before byte stuffing was
+ * performed a word at a time. The cost of a command lookup is measured for
+ * command tables of increasing size.
+ */
+
+//------------------------------------------------------------------------------
+// Includes
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "Fifo.h"
+#include "MaskedFifo.h"
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+#include "x-IMU3-Device/Ximu3.h"
+#include "Ximu3Decoder/Ximu3Decoder.h"
+
+//------------------------------------------------------------------------------
+// Definitions
+
+/**
+ * @brief Number of messages in the stream.
+ */
+#define NUMBER_OF_MESSAGES (100000)
+
+/**
+ * @brief Number of times each benchmark is repeated. The fastest is reported.
+ */
+#define NUMBER_OF_REPEATS (5)
+
+/**
+ * @brief FIFO data size. Equal to the USB CDC write buffer size.
+ */
+#define FIFO_DATA_SIZE (4096)
+
+/**
+ * @brief Number of bytes passed through the FIFO.
+ */
+#define FIFO_NUMBER_OF_BYTES (16 * 1024 * 1024)
+
+/**
+ * @brief FIFO block size. Not a divisor of the data size so that blocks wrap
+ * around the end of the FIFO.
+ */
+#define FIFO_BLOCK_SIZE (61)
+
+/**
+ * @brief Message encoder.
+ */
+typedef size_t(*Encode) (void* const destination, const size_t destinationSize, const void* const data);
+
+/**
+ * @brief FIFO benchmark. Returns the sum of the bytes read.
+ */
+typedef uint32_t(*FifoBenchmark) (void);
+
+/**
+ * @brief Number of command messages received per measurement.
+ */
+#define NUMBER_OF_LOOKUPS (100000)
+
+/**
+ * @brief Command table entries. Keys are "command_0000" to "command_3333" in
+ * base 4 so that keys differ only in the last characters, which is the worst
+ * case for KeyMatches.
+ */
+#define COMMAND(digits) {"command_" #digits, Command}
+#define COMMANDS_4(digits) COMMAND(digits##0), COMMAND(digits##1), COMMAND(digits##2), COMMAND(digits##3)
+#define COMMANDS_16(digits) COMMANDS_4(digits##0), COMMANDS_4(digits##1), COMMANDS_4(digits##2), COMMANDS_4(digits##3)
+#define COMMANDS_64(digits) COMMANDS_16(digits##0), COMMANDS_16(digits##1), COMMANDS_16(digits##2), COMMANDS_16(digits##3)
+#define COMMANDS_256 COMMANDS_64(0), COMMANDS_64(1), COMMANDS_64(2), COMMANDS_64(3)
+
+//------------------------------------------------------------------------------
+// Function declarations
+
+static void Benchmark(const char* const name, const Encode encode, const void* const data);
+static size_t InertialBinary(void* const destination, const size_t destinationSize, const void* const data);
+static size_t InertialBinaryByteWise(void* const destination, const size_t destinationSize, const void* const data);
+static void ByteWiseWrite(void* const destination, const size_t destinationSize, size_t * const destinationIndex, const uint8_t byte);
+static size_t InertialAscii(void* const destination, const size_t destinationSize, const void* const data);
+static size_t TemperatureBinary(void* const destination, const size_t destinationSize, const void* const data);
+static size_t TemperatureAscii(void* const destination, const size_t destinationSize, const void* const data);
+static size_t TemperatureFixedBinary(void* const destination, const size_t destinationSize, const void* const data);
+static size_t TemperatureFixedAscii(void* const destination, const size_t destinationSize, const void* const data);
+static void BenchmarkFifo(const char* const name, const FifoBenchmark byteBenchmark, const FifoBenchmark blockBenchmark);
+static uint32_t FifoBytes(void);
+static uint32_t FifoBlocks(void);
+static uint32_t MaskedFifoBytes(void);
+static uint32_t MaskedFifoBlocks(void);
+static void BenchmarkCommand(const int numberOfCommands);
+static double CommandSeconds(Ximu3CommandBridge * const bridge, const char* const key, uint32_t * const count);
+static void Command(const char* * const value, Ximu3CommandResponse * const response, void* const context);
+static void CommandWrite(const void* const data, const size_t numberOfBytes, void* const context);
+static double Seconds(void);
+static uint64_t Cycles(void);
+static void Message(const Ximu3DecoderMessage * const message, void* const context);
+
+//------------------------------------------------------------------------------
+// Variables
+
+static uint8_t stream[NUMBER_OF_MESSAGES * 128];
+static uint8_t fifoData[FIFO_DATA_SIZE];
+static uint8_t block[FIFO_BLOCK_SIZE];
+
+static const Ximu3CommandMap commands[] = {
+    COMMANDS_256,
+};
+
+static const Ximu3CommandInterface commandInterface = {.name = "Benchmark", .write = CommandWrite};
+
+static Ximu3Settings settings;
+
+//------------------------------------------------------------------------------
+// Functions
+
+/**
+ * @brief Runs the benchmarks.
+ * @return EXIT_SUCCESS.
+ */
+int main(void) {
+    const Ximu3DataInertial inertial = {.timestamp = 1234567890, .gyroscopeX = 12.345f, .gyroscopeY = -0.5f, .gyroscopeZ = 250.0f, .accelerometerX = 0.01f, .accelerometerY = -0.98f, .accelerometerZ = 0.1f};
+    const Ximu3DataTemperature temperature = {.timestamp = 1234567890, .temperature = 25.5f};
+    const Ximu3DataTemperatureFixed temperatureFixed = {.timestamp = 1234567890, .temperature = 3264};
+    printf("%-24s %14s %14s %14s\n", "Message", "Encode (msg/s)", "Decode (msg/s)", "Decode (MB/s)");
+    Benchmark("Inertial binary", InertialBinary, &inertial);
+    Benchmark("Inertial binary (byte)", InertialBinaryByteWise, &inertial);
+    Benchmark("Inertial ASCII", InertialAscii, &inertial);
+    Benchmark("Temperature binary", TemperatureBinary, &temperature);
+    Benchmark("Temperature ASCII", TemperatureAscii, &temperature);
+    Benchmark("Fixed temperature binary", TemperatureFixedBinary, &temperatureFixed);
+    Benchmark("Fixed temperature ASCII", TemperatureFixedAscii, &temperatureFixed);
+    printf("\n%-24s %14s %14s\n", "FIFO", "Byte (cyc/B)", "Block (cyc/B)");
+    BenchmarkFifo("Fifo", FifoBytes, FifoBlocks);
+    BenchmarkFifo("MaskedFifo", MaskedFifoBytes, MaskedFifoBlocks);
+    printf("\n%-24s %14s %14s %14s %14s\n", "Commands", "First (ns)", "Last (ns)", "Setting (ns)", "Scan (ns/cmd)");
+    Ximu3SettingsInitialise(&settings);
+    Ximu3SettingsLoadDefaults(&settings, true);
+    for (int numberOfCommands = 4; numberOfCommands <= (int) (sizeof (commands) / sizeof (Ximu3CommandMap)); numberOfCommands *= 4) {
+        BenchmarkCommand(numberOfCommands);
+    }
+    return EXIT_SUCCESS;
+}
+
+/**
+ * @brief Encodes a stream of messages and then decodes the stream.
+ * @param name Name.
+ * @param encode Encoder.
+ * @param data Data.
+ */
+static void Benchmark(const char* const name, const Encode encode, const void* const data) {
+    double encodeSeconds = 1E9;
+    double decodeSeconds = 1E9;
+    size_t streamSize = 0;
+    uint32_t numberOfMessages = 0;
+    for (int repeat = 0; repeat < NUMBER_OF_REPEATS; repeat++) {
+
+        // Encode
+        double start = Seconds();
+        streamSize = 0;
+        for (int index = 0; index < NUMBER_OF_MESSAGES; index++) {
+            streamSize += encode(&stream[streamSize], sizeof (stream) - streamSize, data);
+        }
+        double seconds = Seconds() - start;
+        if (seconds < encodeSeconds) {
+            encodeSeconds = seconds;
+        }
+
+        // Decode
+        numberOfMessages = 0;
+        Ximu3Decoder decoder = {.message = Message, .context = &numberOfMessages};
+        start = Seconds();
+        Ximu3DecoderProcess(&decoder, stream, streamSize);
+        seconds = Seconds() - start;
+        if (seconds < decodeSeconds) {
+            decodeSeconds = seconds;
+        }
+    }
+    if (numberOfMessages != NUMBER_OF_MESSAGES) {
+        printf("%s: %u of %u messages decoded\n", name, numberOfMessages, NUMBER_OF_MESSAGES);
+        return;
+    }
+    printf("%-24s %14.0f %14.0f %14.1f\n", name, NUMBER_OF_MESSAGES / encodeSeconds, NUMBER_OF_MESSAGES / decodeSeconds, (streamSize / decodeSeconds) / 1E6);
+}
+
+/**
+ * @brief Writes binary inertial data message.
+ * @param destination Destination.
+ * @param destinationSize Destination size.
+ * @param data Data.
+ * @return Message size.
+ */
+static size_t InertialBinary(void* const destination, const size_t destinationSize, const void* const data) {
+    return Ximu3DataInertialBinary(destination, destinationSize, data);
+}
+
+/**
+ * @brief Writes binary inertial data message one byte at a time with a bounds
+ * check per byte.
+ * @param destination Destination.
+ * @param destinationSize Destination size.
+ * @param data Data.
+ * @return Message size.
+ */
+static size_t InertialBinaryByteWise(void* const destination, const size_t destinationSize, const void* const data) {
+    const Ximu3DataInertial * const inertial = data;
+    size_t destinationIndex = 0;
+    ByteWiseWrite(destination, destinationSize, &destinationIndex, 0x80 + 'I');
+    for (int index = 0; index < 8; index++) {
+        ByteWiseWrite(destination, destinationSize, &destinationIndex, (inertial->timestamp >> (8 * index)) & 0xFF);
+    }
+    const float values[] = {inertial->gyroscopeX, inertial->gyroscopeY, inertial->gyroscopeZ, inertial->accelerometerX, inertial->accelerometerY, inertial->accelerometerZ};
+    for (size_t value = 0; value < (sizeof (values) / sizeof (values[0])); value++) {
+        uint32_t bits;
+        memcpy(&bits, &values[value], sizeof (bits));
+        for (int index = 0; index < 4; index++) {
+            ByteWiseWrite(destination, destinationSize, &destinationIndex, (bits >> (8 * index)) & 0xFF);
+        }
+    }
+    if (destinationIndex < destinationSize) {
+        ((uint8_t*) destination)[destinationIndex++] = 0x0A;
+    }
+    return destinationIndex;
+}
+
+/**
+ * @brief Writes a byte with byte stuffing and a bounds check.
+ * @param destination Destination.
+ * @param destinationSize Destination size.
+ * @param destinationIndex Destination index.
+ * @param byte Byte.
+ */
+static void ByteWiseWrite(void* const destination, const size_t destinationSize, size_t * const destinationIndex, const uint8_t byte) {
+    if (*destinationIndex >= destinationSize) {
+        return;
+    }
+    switch (byte) {
+        case 0x0A:
+            ((uint8_t*) destination)[(*destinationIndex)++] = 0xDB;
+            ((uint8_t*) destination)[(*destinationIndex)++] = 0xDC;
+            break;
+        case 0xDB:
+            ((uint8_t*) destination)[(*destinationIndex)++] = 0xDB;
+            ((uint8_t*) destination)[(*destinationIndex)++] = 0xDD;
+            break;
+        default:
+            ((uint8_t*) destination)[(*destinationIndex)++] = byte;
+            break;
+    }
+}
+
+/**
+ * @brief Writes ASCII inertial data message.
+ * @param destination Destination.
+ * @param destinationSize Destination size.
+ * @param data Data.
+ * @return Message size.
+ */
+static size_t InertialAscii(void* const destination, const size_t destinationSize, const void* const data) {
+    return Ximu3DataInertialAscii(destination, destinationSize, data);
+}
+
+/**
+ * @brief Writes binary temperature data message.
+ * @param destination Destination.
+ * @param destinationSize Destination size.
+ * @param data Data.
+ * @return Message size.
+ */
+static size_t TemperatureBinary(void* const destination, const size_t destinationSize, const void* const data) {
+    return Ximu3DataTemperatureBinary(destination, destinationSize, data);
+}
+
+/**
+ * @brief Writes ASCII temperature data message.
+ * @param destination Destination.
+ * @param destinationSize Destination size.
+ * @param data Data.
+ * @return Message size.
+ */
+static size_t TemperatureAscii(void* const destination, const size_t destinationSize, const void* const data) {
+    return Ximu3DataTemperatureAscii(destination, destinationSize, data);
+}
+
+/**
+ * @brief Writes binary fixed-point temperature data message.
+ * @param destination Destination.
+ * @param destinationSize Destination size.
+ * @param data Data.
+ * @return Message size.
+ */
+static size_t TemperatureFixedBinary(void* const destination, const size_t destinationSize, const void* const data) {
+    return Ximu3DataTemperatureFixedBinary(destination, destinationSize, data);
+}
+
+/**
+ * @brief Writes ASCII fixed-point temperature data message.
+ * @param destination Destination.
+ * @param destinationSize Destination size.
+ * @param data Data.
+ * @return Message size.
+ */
+static size_t TemperatureFixedAscii(void* const destination, const size_t destinationSize, const void* const data) {
+    return Ximu3DataTemperatureFixedAscii(destination, destinationSize, data);
+}
+
+/**
+ * @brief Passes bytes through a FIFO using the byte functions and then the
+ * block functions. The sums of the bytes read must be equal.
+ * @param name Name.
+ * @param byteBenchmark Byte function benchmark.
+ * @param blockBenchmark Block function benchmark.
+ */
+static void BenchmarkFifo(const char* const name, const FifoBenchmark byteBenchmark, const FifoBenchmark blockBenchmark) {
+    uint64_t byteCycles = UINT64_MAX;
+    uint64_t blockCycles = UINT64_MAX;
+    uint32_t byteSum = 0;
+    uint32_t blockSum = 0;
+    for (int repeat = 0; repeat < NUMBER_OF_REPEATS; repeat++) {
+        uint64_t start = Cycles();
+        byteSum = byteBenchmark();
+        uint64_t cycles = Cycles() - start;
+        if (cycles < byteCycles) {
+            byteCycles = cycles;
+        }
+        start = Cycles();
+        blockSum = blockBenchmark();
+        cycles = Cycles() - start;
+        if (cycles < blockCycles) {
+            blockCycles = cycles;
+        }
+    }
+    if (byteSum != blockSum) {
+        printf("%s: byte and block sums differ\n", name);
+        return;
+    }
+    printf("%-24s %14.2f %14.2f\n", name, (double) byteCycles / FIFO_NUMBER_OF_BYTES, (double) blockCycles / FIFO_NUMBER_OF_BYTES);
+}
+
+/**
+ * @brief Writes and reads bytes using the Fifo byte functions.
+ * @return Sum of the bytes read.
+ */
+static uint32_t FifoBytes(void) {
+    Fifo fifo = {.data = fifoData, .dataSize = sizeof (fifoData)};
+    uint32_t sum = 0;
+    for (uint32_t index = 0; index < FIFO_NUMBER_OF_BYTES; index += FIFO_BLOCK_SIZE) {
+        for (int byte = 0; byte < FIFO_BLOCK_SIZE; byte++) {
+            FifoWriteByte(&fifo, (uint8_t) (index + byte));
+        }
+        for (int byte = 0; byte < FIFO_BLOCK_SIZE; byte++) {
+            sum += FifoReadByte(&fifo);
+        }
+    }
+    return sum;
+}
+
+/**
+ * @brief Writes and reads blocks using the Fifo block functions.
+ * @return Sum of the bytes read.
+ */
+static uint32_t FifoBlocks(void) {
+    Fifo fifo = {.data = fifoData, .dataSize = sizeof (fifoData)};
+    uint32_t sum = 0;
+    for (uint32_t index = 0; index < FIFO_NUMBER_OF_BYTES; index += FIFO_BLOCK_SIZE) {
+        for (int byte = 0; byte < FIFO_BLOCK_SIZE; byte++) {
+            block[byte] = (uint8_t) (index + byte);
+        }
+        FifoWrite(&fifo, block, sizeof (block));
+        FifoRead(&fifo, block, sizeof (block));
+        for (int byte = 0; byte < FIFO_BLOCK_SIZE; byte++) {
+            sum += block[byte];
+        }
+    }
+    return sum;
+}
+
+/**
+ * @brief Writes and reads bytes using the MaskedFifo byte functions.
+ * @return Sum of the bytes read.
+ */
+static uint32_t MaskedFifoBytes(void) {
+    MaskedFifo fifo = {.data = fifoData, .mask = sizeof (fifoData) - 1};
+    uint32_t sum = 0;
+    for (uint32_t index = 0; index < FIFO_NUMBER_OF_BYTES; index += FIFO_BLOCK_SIZE) {
+        for (int byte = 0; byte < FIFO_BLOCK_SIZE; byte++) {
+            MaskedFifoWriteByte(&fifo, (uint8_t) (index + byte));
+        }
+        for (int byte = 0; byte < FIFO_BLOCK_SIZE; byte++) {
+            sum += MaskedFifoReadByte(&fifo);
+        }
+    }
+    return sum;
+}
+
+/**
+ * @brief Writes and reads blocks using the MaskedFifo block functions.
+ * @return Sum of the bytes read.
+ */
+static uint32_t MaskedFifoBlocks(void) {
+    MaskedFifo fifo = {.data = fifoData, .mask = sizeof (fifoData) - 1};
+    uint32_t sum = 0;
+    for (uint32_t index = 0; index < FIFO_NUMBER_OF_BYTES; index += FIFO_BLOCK_SIZE) {
+        for (int byte = 0; byte < FIFO_BLOCK_SIZE; byte++) {
+            block[byte] = (uint8_t) (index + byte);
+        }
+        MaskedFifoWrite(&fifo, block, sizeof (block));
+        MaskedFifoRead(&fifo, block, sizeof (block));
+        for (int byte = 0; byte < FIFO_BLOCK_SIZE; byte++) {
+            sum += block[byte];
+        }
+    }
+    return sum;
+}
+
+/**
+ * @brief Receives commands for the first and last entries of a command table
+ * and for a setting. Commands are found by a linear search of the table and
+ * settings are only looked up after the search fails, so the cost of both
+ * increases with the table size.
+ * @param numberOfCommands Number of commands in the table.
+ */
+static void BenchmarkCommand(const int numberOfCommands) {
+    uint32_t count = 0;
+    Ximu3CommandBridge bridge = {
+        .commands = &commands[(sizeof (commands) / sizeof (Ximu3CommandMap)) - numberOfCommands],
+        .numberOfCommands = numberOfCommands,
+        .settings = &settings,
+        .context = &count,
+    };
+    const double firstSeconds = CommandSeconds(&bridge, bridge.commands[0].key, &count);
+    const double lastSeconds = CommandSeconds(&bridge, bridge.commands[numberOfCommands - 1].key, &count);
+    const double settingSeconds = CommandSeconds(&bridge, "binary_mode_enabled", &count);
+    if ((firstSeconds < 0) || (lastSeconds < 0) || (settingSeconds < 0)) {
+        printf("%d: command not found\n", numberOfCommands);
+        return;
+    }
+    const double nanoseconds = 1E9 / NUMBER_OF_LOOKUPS;
+    printf("%-24d %14.1f %14.1f %14.1f %14.2f\n", numberOfCommands, firstSeconds * nanoseconds, lastSeconds * nanoseconds, settingSeconds * nanoseconds, ((lastSeconds - firstSeconds) * nanoseconds) / (numberOfCommands - 1));
+}
+
+/**
+ * @brief Receives a command message for a key. Each command or setting
+ * response increments the count.
+ * @param bridge Bridge.
+ * @param key Key.
+ * @param count Count.
+ * @return Fastest time to receive the messages in seconds, or -1 if a message
+ * was not responded to.
+ */
+static double CommandSeconds(Ximu3CommandBridge * const bridge, const char* const key, uint32_t * const count) {
+    char message[XIMU3_OBJECT_SIZE];
+    const size_t messageSize = (size_t) snprintf(message, sizeof (message), "{\"%s\":null}\n", key);
+    double fastest = 1E9;
+    for (int repeat = 0; repeat < NUMBER_OF_REPEATS; repeat++) {
+        *count = 0;
+        const double start = Seconds();
+        for (int index = 0; index < NUMBER_OF_LOOKUPS; index++) {
+            Ximu3CommandReceive(bridge, &commandInterface, message, messageSize);
+        }
+        const double seconds = Seconds() - start;
+        if (seconds < fastest) {
+            fastest = seconds;
+        }
+        if (*count != NUMBER_OF_LOOKUPS) {
+            return -1;
+        }
+    }
+    return fastest;
+}
+
+/**
+ * @brief Command callback. Increments the count without responding.
+ * @param value Value.
+ * @param response Response.
+ * @param context Context.
+ */
+static void Command(const char* * const value, Ximu3CommandResponse * const response, void* const context) {
+    (*(uint32_t*) context)++;
+}
+
+/**
+ * @brief Command interface write. Discards the response and increments the
+ * count.
+ * @param data Data.
+ * @param numberOfBytes Number of bytes.
+ * @param context Context.
+ */
+static void CommandWrite(const void* const data, const size_t numberOfBytes, void* const context) {
+    (*(uint32_t*) context)++;
+}
+
+/**
+ * @brief Returns the monotonic clock in seconds.
+ * @return Monotonic clock in seconds.
+ */
+static double Seconds(void) {
+    struct timespec timespec;
+    clock_gettime(CLOCK_MONOTONIC, &timespec);
+    return (double) timespec.tv_sec + ((double) timespec.tv_nsec * 1E-9);
+}
+
+/**
+ * @brief Returns the processor time stamp counter. The monotonic clock in
+ * nanoseconds is returned if the time stamp counter is not available.
+ * @return Processor time stamp counter.
+ */
+static uint64_t Cycles(void) {
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    struct timespec timespec;
+    clock_gettime(CLOCK_MONOTONIC, &timespec);
+    return ((uint64_t) timespec.tv_sec * 1000000000) + (uint64_t) timespec.tv_nsec;
+#endif
+}
+
+/**
+ * @brief Decoder message callback. Counts the messages.
+ * @param message Message.
+ * @param context Context.
+ */
+static void Message(const Ximu3DecoderMessage * const message, void* const context) {
+    (*(uint32_t*) context)++;
+}
+
+//------------------------------------------------------------------------------
+// End of file
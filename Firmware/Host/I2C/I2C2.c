@@ -0,0 +1,432 @@
+/**
+ * @file I2C2.c
+ * @author Seb Madgwick
+ * @brief Host stand-in for the I2C2 driver. Bus events are passed to the
+ * client models attached using the functions in I2C2Host.h. Each event takes
+ * the time of the bits on the bus. Blocking functions advance the simulated
+ * timer by this time. Queued transfers complete in I2C2Tasks once this time
+ * has elapsed. A stalled queued transfer times out and the bus is recovered
+ * with a stop event, the same as the device.
+ */
+
+//------------------------------------------------------------------------------
+// Includes
+
+#include "Config.h"
+#include "I2C/I2C2.h"
+#include "I2C2Host.h"
+#include "Timer/Timer.h"
+
+//------------------------------------------------------------------------------
+// Definitions
+
+/**
+ * @brief Number of clock cycles of a byte and the ACK/NACK.
+ */
+#define BYTE_CLOCK_CYCLES (9)
+
+//------------------------------------------------------------------------------
+// Function declarations
+
+static I2CHostResponse BusStart(void);
+static I2CHostResponse BusSend(const uint8_t byte);
+static I2CHostResponse BusReceive(uint8_t * const byte);
+static void BusStop(void);
+static void BusRecover(void);
+static void Wait(const I2CHostResponse response, const uint32_t clockCycles);
+static void WaitForTransfers(void);
+static void StartTransfer(void);
+static uint32_t TransferClockCycles(const I2CTransfer * const transfer);
+static I2CHostResponse TransferPerform(const I2CTransfer * const transfer);
+static void TransferComplete(void);
+
+//------------------------------------------------------------------------------
+// Variables
+
+const I2C i2c2 = {
+    .start = I2C2Start,
+    .repeatedStart = I2C2RepeatedStart,
+    .stop = I2C2Stop,
+    .send = I2C2Send,
+    .sendAddressRead = I2C2SendAddressRead,
+    .sendAddressWrite = I2C2SendAddressWrite,
+    .receive = I2C2Receive,
+};
+
+static const I2CHostClient* clients[I2C2_HOST_MAXIMUM_NUMBER_OF_CLIENTS];
+static int numberOfClients;
+static const I2CHostClient* addressedClient;
+static bool addressPending;
+static uint64_t clockTicks = TIMER_TICKS_PER_SECOND / I2CClockFrequency400kHz;
+static uint64_t timeout = I2C_TIMEOUT(I2CClockFrequency400kHz);
+static I2CTransfer* queue[I2C2_TRANSFER_QUEUE_LENGTH];
+static int queueWriteIndex;
+static int queueReadIndex;
+static bool busy;
+static bool blocking;
+static bool performed;
+static uint64_t transferEnd;
+static I2CTransferResult result;
+
+//------------------------------------------------------------------------------
+// Functions
+
+/**
+ * @brief Initialises the module.
+ * @param clockFrequency Clock frequency.
+ */
+void I2C2Initialise(const I2CClockFrequency clockFrequency) {
+    I2C2Deinitialise();
+    clockTicks = TIMER_TICKS_PER_SECOND / clockFrequency;
+    timeout = I2C_TIMEOUT(clockFrequency);
+}
+
+/**
+ * @brief Disables the module. Queued transfers are discarded.
+ */
+void I2C2Deinitialise(void) {
+    queueWriteIndex = 0;
+    queueReadIndex = 0;
+    busy = false;
+    blocking = false;
+    addressedClient = NULL;
+    addressPending = false;
+}
+
+/**
+ * @brief Module tasks. Completes the transfer in progress if the time of the
+ * transfer has elapsed. This function should be called repeatedly within the
+ * main program loop if transfers are used.
+ */
+void I2C2Tasks(void) {
+    if ((busy == false) || (TimerGetTicks64() < transferEnd)) {
+        return;
+    }
+    if (performed) {
+        if (result == I2CTransferResultTimeout) {
+            BusRecover();
+        }
+        TransferComplete();
+        return;
+    }
+    performed = true;
+    switch (TransferPerform(queue[queueReadIndex])) {
+        case I2CHostResponseAck:
+            result = I2CTransferResultOk;
+            break;
+        case I2CHostResponseNack:
+            result = I2CTransferResultNack;
+            break;
+        case I2CHostResponseStall:
+            result = I2CTransferResultTimeout;
+            transferEnd += timeout; // abandoned by the timeout
+            return;
+    }
+    TransferComplete();
+}
+
+/**
+ * @brief Queues a transfer. The callback is called from I2C2Tasks on
+ * completion.
+ * @param transfer Transfer.
+ * @return True if the transfer was queued, false if the queue was full.
+ */
+bool I2C2Transfer(I2CTransfer * const transfer) {
+    const int nextIndex = (queueWriteIndex + 1) % I2C2_TRANSFER_QUEUE_LENGTH;
+    if (nextIndex == queueReadIndex) {
+        return false;
+    }
+    queue[queueWriteIndex] = transfer;
+    queueWriteIndex = nextIndex;
+    if (busy == false) {
+        StartTransfer();
+    }
+    return true;
+}
+
+/**
+ * @brief Returns true if a transfer is in progress or queued.
+ * @return True if a transfer is in progress or queued.
+ */
+bool I2C2TransferInProgress(void) {
+    return busy;
+}
+
+/**
+ * @brief Generates a start event. Queued transfers will complete first.
+ */
+void I2C2Start(void) {
+    WaitForTransfers();
+    blocking = true;
+    Wait(BusStart(), 1);
+}
+
+/**
+ * @brief Generates a repeated start event.
+ */
+void I2C2RepeatedStart(void) {
+    Wait(BusStart(), 1);
+}
+
+/**
+ * @brief Generates a stop event. Queued transfers will resume.
+ */
+void I2C2Stop(void) {
+    BusStop();
+    Wait(I2CHostResponseAck, 1);
+    blocking = false;
+    StartTransfer();
+}
+
+/**
+ * @brief Sends a byte and checks for ACK.
+ * @param byte Byte.
+ * @return True if an ACK was generated.
+ */
+bool I2C2Send(const uint8_t byte) {
+    const I2CHostResponse response = BusSend(byte);
+    Wait(response, BYTE_CLOCK_CYCLES);
+    return response == I2CHostResponseAck;
+}
+
+/**
+ * @brief Sends a 7-bit client address with appended R/W bit to indicate a
+ * read.
+ * @param address 7-bit client address.
+ * @return True if an ACK was generated.
+ */
+bool I2C2SendAddressRead(const uint8_t address) {
+    return I2C2Send(I2CAddressRead(address));
+}
+
+/**
+ * @brief Sends a 7-bit client address with appended R/W bit to indicate a
+ * write.
+ * @param address 7-bit client address.
+ * @return True if an ACK was generated.
+ */
+bool I2C2SendAddressWrite(const uint8_t address) {
+    return I2C2Send(I2CAddressWrite(address));
+}
+
+/**
+ * @brief Receives a byte and generates an ACK or NACK.
+ * @param ack True for ACK.
+ * @return Byte.
+ */
+uint8_t I2C2Receive(const bool ack) {
+    uint8_t byte = 0xFF;
+    Wait(BusReceive(&byte), BYTE_CLOCK_CYCLES);
+    return byte;
+}
+
+/**
+ * @brief I2C master interrupt handler. Not used by the stand-in.
+ */
+void I2C2MasterInterruptHandler(void) {
+}
+
+/**
+ * @brief Attaches a client to the bus.
+ * @param client Client.
+ * @return True if the client was attached, false if the maximum number of
+ * clients are attached.
+ */
+bool I2C2HostAttach(const I2CHostClient * const client) {
+    if (numberOfClients >= I2C2_HOST_MAXIMUM_NUMBER_OF_CLIENTS) {
+        return false;
+    }
+    clients[numberOfClients++] = client;
+    return true;
+}
+
+/**
+ * @brief Detaches all clients from the bus.
+ */
+void I2C2HostDetachAll(void) {
+    numberOfClients = 0;
+    addressedClient = NULL;
+}
+
+/**
+ * @brief Start or repeated start event. The next byte is the client address.
+ * @return Response.
+ */
+static I2CHostResponse BusStart(void) {
+    addressedClient = NULL;
+    addressPending = true;
+    return I2CHostResponseAck;
+}
+
+/**
+ * @brief Sends a byte to the addressed client or, after a start event, sends
+ * the client address. An address is NACKed if no client has the address.
+ * @param byte Byte.
+ * @return Response.
+ */
+static I2CHostResponse BusSend(const uint8_t byte) {
+    if (addressPending) {
+        addressPending = false;
+        for (int index = 0; index < numberOfClients; index++) {
+            if (clients[index]->address == (byte >> 1)) {
+                const I2CHostResponse response = clients[index]->start((byte & 1) != 0);
+                if (response == I2CHostResponseAck) {
+                    addressedClient = clients[index];
+                }
+                return response;
+            }
+        }
+        return I2CHostResponseNack;
+    }
+    if (addressedClient == NULL) {
+        return I2CHostResponseNack;
+    }
+    return addressedClient->write(byte);
+}
+
+/**
+ * @brief Receives a byte from the addressed client. The byte is 0xFF if no
+ * client is addressed.
+ * @param byte Byte.
+ * @return Response.
+ */
+static I2CHostResponse BusReceive(uint8_t * const byte) {
+    if (addressedClient == NULL) {
+        return I2CHostResponseAck;
+    }
+    return addressedClient->read(byte);
+}
+
+/**
+ * @brief Stop event.
+ */
+static void BusStop(void) {
+    if (addressedClient != NULL) {
+        addressedClient->stop();
+    }
+    addressedClient = NULL;
+    addressPending = false;
+}
+
+/**
+ * @brief Bus recovery. The stop event is seen by all clients.
+ */
+static void BusRecover(void) {
+    for (int index = 0; index < numberOfClients; index++) {
+        clients[index]->stop();
+    }
+    addressedClient = NULL;
+    addressPending = false;
+}
+
+/**
+ * @brief Waits for the time of an event. A stalled event waits for the
+ * timeout and the addressed client is abandoned.
+ * @param response Response.
+ * @param clockCycles Number of clock cycles of the event.
+ */
+static void Wait(const I2CHostResponse response, const uint32_t clockCycles) {
+    uint64_t ticks = clockTicks * clockCycles;
+    if (response == I2CHostResponseStall) {
+        ticks = timeout;
+        addressedClient = NULL;
+    }
+    const uint64_t end = TimerGetTicks64() + ticks;
+    TimerAdvance(ticks);
+    while (TimerGetTicks64() < end);
+}
+
+/**
+ * @brief Waits for queued transfers to complete or timeout.
+ */
+static void WaitForTransfers(void) {
+    while (busy) {
+        const uint64_t ticks = TimerGetTicks64();
+        if (transferEnd > ticks) {
+            TimerAdvance(transferEnd - ticks);
+        }
+        I2C2Tasks();
+    }
+}
+
+/**
+ * @brief Starts the next queued transfer. The transfer is performed once the
+ * time of the transfer has elapsed.
+ */
+static void StartTransfer(void) {
+    if (blocking || (queueReadIndex == queueWriteIndex)) {
+        busy = false;
+        return;
+    }
+    busy = true;
+    performed = false;
+    transferEnd = TimerGetTicks64() + (clockTicks * TransferClockCycles(queue[queueReadIndex]));
+}
+
+/**
+ * @brief Returns the number of clock cycles of a transfer.
+ * @param transfer Transfer.
+ * @return Number of clock cycles.
+ */
+static uint32_t TransferClockCycles(const I2CTransfer * const transfer) {
+    uint32_t clockCycles = 1 + BYTE_CLOCK_CYCLES + (BYTE_CLOCK_CYCLES * transfer->numberOfWriteBytes) + 1;
+    if (transfer->numberOfReadBytes > 0) {
+        if (transfer->numberOfWriteBytes > 0) {
+            clockCycles += 1 + BYTE_CLOCK_CYCLES;
+        }
+        clockCycles += BYTE_CLOCK_CYCLES * transfer->numberOfReadBytes;
+    }
+    return clockCycles;
+}
+
+/**
+ * @brief Performs the bus events of a transfer.
+ * @param transfer Transfer.
+ * @return Response. A stalled transfer is abandoned without a stop event
+ * until the bus is recovered.
+ */
+static I2CHostResponse TransferPerform(const I2CTransfer * const transfer) {
+    I2CHostResponse response = BusStart();
+    if (transfer->numberOfWriteBytes > 0) {
+        response = BusSend(I2CAddressWrite(transfer->address));
+        for (size_t index = 0; (index < transfer->numberOfWriteBytes) && (response == I2CHostResponseAck); index++) {
+            response = BusSend(transfer->writeData[index]);
+        }
+        if ((response == I2CHostResponseAck) && (transfer->numberOfReadBytes > 0)) {
+            response = BusStart();
+        }
+    }
+    if ((response == I2CHostResponseAck) && (transfer->numberOfReadBytes > 0)) {
+        response = BusSend(I2CAddressRead(transfer->address));
+        for (size_t index = 0; (index < transfer->numberOfReadBytes) && (response == I2CHostResponseAck); index++) {
+            transfer->readData[index] = 0xFF;
+            response = BusReceive(&transfer->readData[index]);
+        }
+    }
+    if (response == I2CHostResponseStall) {
+        addressedClient = NULL;
+        addressPending = false;
+        return response;
+    }
+    BusStop();
+    return response;
+}
+
+/**
+ * @brief Removes the transfer from the queue, calls the callback, and starts
+ * the next transfer.
+ */
+static void TransferComplete(void) {
+    const I2CTransfer * const transfer = queue[queueReadIndex];
+    queueReadIndex = (queueReadIndex + 1) % I2C2_TRANSFER_QUEUE_LENGTH;
+    busy = false;
+    if (transfer->callback != NULL) {
+        transfer->callback(result, transfer->context);
+    }
+    if (busy == false) { // callback may have started a transfer
+        StartTransfer();
+    }
+}
+
+//------------------------------------------------------------------------------
+// End of file
@@ -0,0 +1,59 @@
+/**
+ * @file I2C2Host.h
+ * @author Seb Madgwick
+ * @brief Client side of the I2C2 stand-in. Client models are attached to the
+ * virtual bus and respond to each bus event.
+ */
+
+#ifndef I2C2_HOST_H
+#define I2C2_HOST_H
+
+//------------------------------------------------------------------------------
+// Includes
+
+#include <stdbool.h>
+#include <stdint.h>
+
+//------------------------------------------------------------------------------
+// Definitions
+
+/**
+ * @brief Maximum number of clients attached to the bus.
+ */
+#define I2C2_HOST_MAXIMUM_NUMBER_OF_CLIENTS (4)
+
+/**
+ * @brief Client response to a bus event. A stall holds the clock low so that
+ * the event does not complete.
+ */
+typedef enum {
+    I2CHostResponseAck,
+    I2CHostResponseNack,
+    I2CHostResponseStall,
+} I2CHostResponse;
+
+/**
+ * @brief Client. The start function is called when the client address is
+ * received after a start or repeated start. The write function is called for
+ * each subsequent byte written and the read function is called for each byte
+ * read. The stop function is called for a stop event while the client is
+ * addressed.
+ */
+typedef struct {
+    uint8_t address;
+    I2CHostResponse(*start)(const bool read);
+    I2CHostResponse(*write)(const uint8_t byte);
+    I2CHostResponse(*read)(uint8_t * const byte);
+    void (*stop)(void);
+} I2CHostClient;
+
+//------------------------------------------------------------------------------
+// Function declarations
+
+bool I2C2HostAttach(const I2CHostClient * const client);
+void I2C2HostDetachAll(void);
+
+#endif
+
+//------------------------------------------------------------------------------
+// End of file
@@ -0,0 +1,37 @@
+/**
+ * @file Led.c
+ * @author Seb Madgwick
+ * @brief Host stand-in for the LED driver. LED events are printed.
+ */
+
+//------------------------------------------------------------------------------
+// Includes
+
+#include "Led/Led.h"
+#include <stdio.h>
+
+//------------------------------------------------------------------------------
+// Functions
+
+/**
+ * @brief Initialises the module.
+ */
+void LedInitialise(void) {
+}
+
+/**
+ * @brief Blinks the LED.
+ */
+void LedBlink(void) {
+    printf("LED blink\n");
+}
+
+/**
+ * @brief Strobes the LED.
+ */
+void LedStrobe(void) {
+    printf("LED strobe\n");
+}
+
+//------------------------------------------------------------------------------
+// End of file
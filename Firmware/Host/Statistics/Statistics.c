@@ -0,0 +1,115 @@
+/**
+ * @file Statistics.c
+ * @author Seb Madgwick
+ * @brief Host stand-in for the main loop timing statistics. The loop and
+ * event statistics are the same as those of the device. The stack is not
+ * measured and so the stack sizes are zero.
+ */
+
+//------------------------------------------------------------------------------
+// Includes
+
+#include "Statistics/Statistics.h"
+#include <string.h>
+#include "Timer/Timer.h"
+
+//------------------------------------------------------------------------------
+// Variables
+
+static uint32_t previousTicks;
+static uint32_t windowStart;
+static uint32_t windowLoops;
+static Statistics statistics;
+
+//------------------------------------------------------------------------------
+// Functions
+
+/**
+ * @brief Initialises the module. This function should be called immediately
+ * before the main program loop.
+ */
+void StatisticsInitialise(void) {
+    previousTicks = TimerGetTicks32();
+    windowStart = previousTicks;
+    windowLoops = 0;
+    StatisticsReset();
+}
+
+/**
+ * @brief Updates the loop statistics. This function should be called once per
+ * iteration of the main program loop.
+ */
+void StatisticsLoop(void) {
+
+    // Loop time
+    const uint32_t ticks = TimerGetTicks32();
+    const uint32_t loopTicks = ticks - previousTicks;
+    previousTicks = ticks;
+    if (loopTicks > statistics.maximumLoopTicks) {
+        statistics.maximumLoopTicks = loopTicks;
+    }
+
+    // Loops per second
+    windowLoops++;
+    if ((ticks - windowStart) >= TIMER_TICKS_PER_SECOND) {
+        statistics.loopsPerSecond = windowLoops;
+        windowLoops = 0;
+        windowStart += TIMER_TICKS_PER_SECOND;
+        if ((ticks - windowStart) >= TIMER_TICKS_PER_SECOND) {
+            windowStart = ticks; // loop stalled for longer than a second
+        }
+    }
+}
+
+/**
+ * @brief Adds the lateness of a periodic event. This function should be called
+ * when the event is serviced.
+ * @param event Event.
+ * @param deadline Deadline in timer ticks.
+ */
+void StatisticsDeadline(const StatisticsEvent event, const uint64_t deadline) {
+    const uint64_t ticks = TimerGetTicks64();
+    const uint32_t lateness = ticks > deadline ? (uint32_t) (ticks - deadline) : 0;
+    StatisticsLateness * const eventLateness = &statistics.lateness[event];
+    eventLateness->count++;
+    eventLateness->total += lateness;
+    if (lateness > eventLateness->maximum) {
+        eventLateness->maximum = lateness;
+    }
+}
+
+/**
+ * @brief Returns the statistics.
+ * @return Statistics.
+ */
+const Statistics* StatisticsGet(void) {
+    return &statistics;
+}
+
+/**
+ * @brief Resets the maximum loop time and the lateness of all events.
+ */
+void StatisticsReset(void) {
+    statistics.maximumLoopTicks = 0;
+    memset(statistics.lateness, 0, sizeof (statistics.lateness));
+}
+
+/**
+ * @brief Returns the event string.
+ * @param event Event.
+ * @return Event string.
+ */
+const char* StatisticsEventToString(const StatisticsEvent event) {
+    switch (event) {
+        case StatisticsEventThermometerPoll:
+            return "thermometer_poll";
+        case StatisticsEventTemperatureOutput:
+            return "temperature_output";
+        case StatisticsEventNumberOfEvents:
+            break;
+    }
+    return ""; // avoid compiler warning
+}
+
+//------------------------------------------------------------------------------
+// End of file
@@ -0,0 +1,72 @@
+/**
+ * @file System.c
+ * @author Seb Madgwick
+ * @brief Host stand-in for the system initialisation and tasks generated by
+ * MPLAB Harmony. The USB CDC buffers are connected to a pseudo-terminal and
+ * the TMP117 model is attached to the I2C2 stand-in.
+ */
+
+//------------------------------------------------------------------------------
+// Includes
+
+#include "definitions.h"
+#include "I2C/I2C2Host.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include "Timer/Timer.h"
+#include "Tmp117/Tmp117.h"
+#include "Usb/UsbCdcHost.h"
+
+//------------------------------------------------------------------------------
+// Functions
+
+/**
+ * @brief Initialises the system. Exits if the pseudo-terminal cannot be
+ * opened.
+ * @param data Not used.
+ */
+void SYS_Initialize(void* data) {
+    setvbuf(stdout, NULL, _IOLBF, 0);
+    const char* const name = UsbCdcHostOpenPty();
+    if (name == NULL) {
+        perror("Unable to open pseudo-terminal");
+        exit(EXIT_FAILURE);
+    }
+    printf("USB CDC %s\n", name);
+    Tmp117Initialise();
+    I2C2HostAttach(&tmp117Client);
+}
+
+/**
+ * @brief System tasks.
+ */
+void SYS_Tasks(void) {
+}
+
+/**
+ * @brief Returns the reset cause. The host device always starts from a
+ * power-on reset.
+ * @return Reset cause.
+ */
+RCON_RESET_CAUSE RCON_ResetCauseGet(void) {
+    return RCON_RESET_CAUSE_POR;
+}
+
+/**
+ * @brief Clears the reset cause.
+ * @param cause Reset cause.
+ */
+void RCON_ResetCauseClear(RCON_RESET_CAUSE cause) {
+}
+
+/**
+ * @brief Returns the CP0 Count register. The register increments at half the
+ * CPU clock frequency.
+ * @return CP0 Count register.
+ */
+uint32_t _CP0_GET_COUNT(void) {
+    return (uint32_t) ((TimerGetTicks64() * (CPU_CLOCK_FREQUENCY / 2)) / TIMER_TICKS_PER_SECOND);
+}
+
+//------------------------------------------------------------------------------
+// End of file
@@ -0,0 +1,86 @@
+/**
+ * @file FilterTest.c
+ * @author Seb Madgwick
+ * @brief Filter unit tests.
+ */
+
+//------------------------------------------------------------------------------
+// Includes
+
+#include "Filter/Filter.h"
+#include "Test.h"
+
+//------------------------------------------------------------------------------
+// Functions
+
+/**
+ * @brief Runs the tests.
+ */
+void FilterTest(void) {
+    int16_t output;
+
+    // Invalid settings are modified
+    FilterSettings settings = {.medianSize = 4, .decimation = 0, .lowPassShift = 100};
+    FilterSetSettings(&settings);
+    TEST_ASSERT_EQUAL(5, settings.medianSize);
+    TEST_ASSERT_EQUAL(1, settings.decimation);
+    TEST_ASSERT_EQUAL(FILTER_MAXIMUM_LOW_PASS_SHIFT, settings.lowPassShift);
+
+    // Default settings pass input to output
+    settings = filterSettingsDefault;
+    FilterSetSettings(&settings);
+    TEST_ASSERT(FilterUpdate(-1234, &output));
+    TEST_ASSERT_EQUAL(-1234, output);
+
+    // Median removes spike
+    settings = (FilterSettings){.medianSize = 3, .decimation = 1, .lowPassShift = 0};
+    FilterSetSettings(&settings);
+    const int16_t spike[] = {100, 100, 5000, 100, 100};
+    for (size_t index = 0; index < (sizeof (spike) / sizeof (spike[0])); index++) {
+        TEST_ASSERT(FilterUpdate(spike[index], &output));
+        TEST_ASSERT_EQUAL(100, output);
+    }
+
+    // Decimation averages and rounds away from zero
+    settings = (FilterSettings){.medianSize = 1, .decimation = 4, .lowPassShift = 0};
+    FilterSetSettings(&settings);
+    TEST_ASSERT(FilterUpdate(1, &output) == false);
+    TEST_ASSERT(FilterUpdate(2, &output) == false);
+    TEST_ASSERT(FilterUpdate(3, &output) == false);
+    TEST_ASSERT(FilterUpdate(4, &output));
+    TEST_ASSERT_EQUAL(3, output);
+    FilterUpdate(-1, &output);
+    FilterUpdate(-2, &output);
+    FilterUpdate(-3, &output);
+    TEST_ASSERT(FilterUpdate(-4, &output));
+    TEST_ASSERT_EQUAL(-3, output);
+
+    // Low-pass starts at first input and converges to step
+    settings = (FilterSettings){.medianSize = 1, .decimation = 1, .lowPassShift = 2};
+    FilterSetSettings(&settings);
+    TEST_ASSERT(FilterUpdate(1000, &output));
+    TEST_ASSERT_EQUAL(1000, output);
+    TEST_ASSERT(FilterUpdate(2000, &output));
+    TEST_ASSERT_EQUAL(1250, output);
+    for (int index = 0; index < 100; index++) {
+        FilterUpdate(2000, &output);
+    }
+    TEST_ASSERT_EQUAL(2000, output);
+
+    // Extreme inputs do not overflow
+    settings = (FilterSettings){.medianSize = FILTER_MAXIMUM_MEDIAN_SIZE, .decimation = FILTER_MAXIMUM_DECIMATION, .lowPassShift = FILTER_MAXIMUM_LOW_PASS_SHIFT};
+    FilterSetSettings(&settings);
+    for (int index = 0; index < FILTER_MAXIMUM_DECIMATION; index++) {
+        FilterUpdate(INT16_MIN, &output);
+    }
+    TEST_ASSERT_EQUAL(INT16_MIN, output);
+    settings = (FilterSettings){.medianSize = FILTER_MAXIMUM_MEDIAN_SIZE, .decimation = FILTER_MAXIMUM_DECIMATION, .lowPassShift = FILTER_MAXIMUM_LOW_PASS_SHIFT};
+    FilterSetSettings(&settings);
+    for (int index = 0; index < FILTER_MAXIMUM_DECIMATION; index++) {
+        FilterUpdate(INT16_MAX, &output);
+    }
+    TEST_ASSERT_EQUAL(INT16_MAX, output);
+}
+
+//------------------------------------------------------------------------------
+// End of file
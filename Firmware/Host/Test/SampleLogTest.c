@@ -0,0 +1,131 @@
+/**
+ * @file SampleLogTest.c
+ * @author Seb Madgwick
+ * @brief Sample log unit tests. The log cannot be cleared and so the tests
+ * run in sequence on the same log.
+ */
+
+//------------------------------------------------------------------------------
+// Includes
+
+#include "SampleLog/SampleLog.h"
+#include "Test.h"
+
+//------------------------------------------------------------------------------
+// Definitions
+
+/**
+ * @brief Number of samples written to fill the log several times over.
+ */
+#define NUMBER_OF_SAMPLES (SAMPLE_LOG_SIZE * 4)
+
+//------------------------------------------------------------------------------
+// Function declarations
+
+static void Sample(const uint32_t index, uint64_t * const timestamp, int16_t * const raw);
+
+//------------------------------------------------------------------------------
+// Functions
+
+/**
+ * @brief Runs the tests.
+ */
+void SampleLogTest(void) {
+    SampleLogCursor cursor;
+    uint64_t timestamp;
+    int16_t raw;
+
+    // Empty log
+    TEST_ASSERT_EQUAL(0, SampleLogNumberOfSamples());
+    SampleLogCursorInitialise(&cursor);
+    TEST_ASSERT(SampleLogRead(&cursor, &timestamp, &raw) == false);
+
+    // Samples read back in order
+    for (uint32_t index = 0; index < 100; index++) {
+        Sample(index, &timestamp, &raw);
+        SampleLogWrite(timestamp, raw);
+    }
+    TEST_ASSERT_EQUAL(100, SampleLogNumberOfSamples());
+    SampleLogCursorInitialise(&cursor);
+    for (uint32_t index = 0; index < 100; index++) {
+        uint64_t expectedTimestamp;
+        int16_t expectedRaw;
+        Sample(index, &expectedTimestamp, &expectedRaw);
+        TEST_ASSERT(SampleLogRead(&cursor, &timestamp, &raw));
+        TEST_ASSERT_EQUAL(expectedTimestamp, timestamp);
+        TEST_ASSERT_EQUAL(expectedRaw, raw);
+    }
+    TEST_ASSERT(SampleLogRead(&cursor, &timestamp, &raw) == false);
+
+    // Cursor ignores samples written after initialisation
+    SampleLogCursorInitialise(&cursor);
+    SampleLogWrite(UINT64_MAX, 0);
+    uint32_t count = 0;
+    while (SampleLogRead(&cursor, &timestamp, &raw)) {
+        count++;
+    }
+    TEST_ASSERT_EQUAL(100, count);
+
+    // Timestamp that goes backwards starts a new block
+    SampleLogWrite(0, INT16_MIN);
+    SampleLogCursorInitialise(&cursor);
+    uint64_t lastTimestamp = 0;
+    int16_t lastRaw = 0;
+    while (SampleLogRead(&cursor, &timestamp, &raw)) {
+        lastTimestamp = timestamp;
+        lastRaw = raw;
+    }
+    TEST_ASSERT_EQUAL(0, lastTimestamp);
+    TEST_ASSERT_EQUAL(INT16_MIN, lastRaw);
+
+    // Oldest samples are overwritten and the newest samples remain
+    for (uint32_t index = 0; index < NUMBER_OF_SAMPLES; index++) {
+        Sample(index, &timestamp, &raw);
+        SampleLogWrite(timestamp + 1, raw);
+    }
+    const uint32_t numberOfSamples = SampleLogNumberOfSamples();
+    TEST_ASSERT((numberOfSamples > 0) && (numberOfSamples < NUMBER_OF_SAMPLES));
+    SampleLogCursorInitialise(&cursor);
+    count = 0;
+    bool match = true;
+    while (SampleLogRead(&cursor, &timestamp, &raw)) {
+        uint64_t expectedTimestamp;
+        int16_t expectedRaw;
+        Sample(NUMBER_OF_SAMPLES - numberOfSamples + count, &expectedTimestamp, &expectedRaw);
+        if ((timestamp != (expectedTimestamp + 1)) || (raw != expectedRaw)) {
+            match = false;
+        }
+        count++;
+    }
+    TEST_ASSERT(match);
+    TEST_ASSERT_EQUAL(numberOfSamples, count);
+
+    // Samples overwritten while reading are skipped
+    SampleLogCursorInitialise(&cursor);
+    TEST_ASSERT(SampleLogRead(&cursor, &timestamp, &raw));
+    const uint64_t firstTimestamp = timestamp;
+    for (uint32_t index = 0; index < numberOfSamples; index++) {
+        SampleLogWrite(UINT64_MAX / 2, 0);
+    }
+    count = 0;
+    while (SampleLogRead(&cursor, &timestamp, &raw)) {
+        TEST_ASSERT(timestamp > firstTimestamp);
+        count++;
+    }
+    TEST_ASSERT(count < numberOfSamples);
+}
+
+/**
+ * @brief Returns the sample for an index. Timestamps are approximately 64 Hz
+ * with jitter and the raw temperature varies by a few codes.
+ * @param index Index.
+ * @param timestamp Timestamp.
+ * @param raw Raw temperature.
+ */
+static void Sample(const uint32_t index, uint64_t * const timestamp, int16_t * const raw) {
+    *timestamp = 1000000 + ((uint64_t) index * 15625) + ((index * 7919) % 100);
+    *raw = (int16_t) (3200 + ((index * 31) % 17) - 8);
+}
+
+//------------------------------------------------------------------------------
+// End of file
@@ -0,0 +1,55 @@
+/**
+ * @file Test.c
+ * @author Seb Madgwick
+ * @brief Runs the host unit tests.
+ */
+
+//------------------------------------------------------------------------------
+// Includes
+
+#include <stdlib.h>
+#include "Test.h"
+
+//------------------------------------------------------------------------------
+// Function declarations
+
+void FilterTest(void);
+void SampleLogTest(void);
+void ThermometerTest(void);
+void TimestampTest(void);
+void UsbCdcTest(void);
+void Ximu3CommandTest(void);
+void Ximu3DataTest(void);
+void Ximu3DecoderTest(void);
+
+//------------------------------------------------------------------------------
+// Variables
+
+int testFailures;
+
+//------------------------------------------------------------------------------
+// Functions
+
+/**
+ * @brief Runs the tests.
+ * @return EXIT_SUCCESS if all tests passed.
+ */
+int main(void) {
+    FilterTest();
+    SampleLogTest();
+    ThermometerTest();
+    TimestampTest();
+    UsbCdcTest();
+    Ximu3CommandTest();
+    Ximu3DataTest();
+    Ximu3DecoderTest();
+    if (testFailures > 0) {
+        printf("%d failures\n", testFailures);
+        return EXIT_FAILURE;
+    }
+    printf("All tests passed\n");
+    return EXIT_SUCCESS;
+}
+
+//------------------------------------------------------------------------------
+// End of file
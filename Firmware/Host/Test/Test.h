@@ -0,0 +1,95 @@
+/**
+ * @file Test.h
+ * @author Seb Madgwick
+ * @brief Minimal unit test assertions for the host build.
+ */
+
+#ifndef TEST_H
+#define TEST_H
+
+//------------------------------------------------------------------------------
+// Includes
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+//------------------------------------------------------------------------------
+// Definitions
+
+/**
+ * @brief Fails the test if the condition is false.
+ */
+#define TEST_ASSERT(condition) TestAssert((condition), #condition, __FILE__, __LINE__)
+
+/**
+ * @brief Fails the test if the integers are not equal.
+ */
+#define TEST_ASSERT_EQUAL(expected, actual) TestAssertEqual((int64_t) (expected), (int64_t) (actual), #actual, __FILE__, __LINE__)
+
+/**
+ * @brief Fails the test if the strings are not equal.
+ */
+#define TEST_ASSERT_STRING(expected, actual) TestAssertString((expected), (actual), __FILE__, __LINE__)
+
+/**
+ * @brief Fails the test if the memory is not equal.
+ */
+#define TEST_ASSERT_MEMORY(expected, actual, numberOfBytes) TestAssert(memcmp((expected), (actual), (numberOfBytes)) == 0, #actual, __FILE__, __LINE__)
+
+//------------------------------------------------------------------------------
+// Variable declarations
+
+extern int testFailures;
+
+//------------------------------------------------------------------------------
+// Inline functions
+
+/**
+ * @brief Fails the test if the condition is false.
+ * @param condition Condition.
+ * @param text Condition text.
+ * @param file File.
+ * @param line Line.
+ */
+static inline void TestAssert(const int condition, const char* const text, const char* const file, const int line) {
+    if (condition == 0) {
+        printf("%s:%d: assertion failed: %s\n", file, line, text);
+        testFailures++;
+    }
+}
+
+/**
+ * @brief Fails the test if the integers are not equal.
+ * @param expected Expected.
+ * @param actual Actual.
+ * @param text Actual text.
+ * @param file File.
+ * @param line Line.
+ */
+static inline void TestAssertEqual(const int64_t expected, const int64_t actual, const char* const text, const char* const file, const int line) {
+    if (expected != actual) {
+        printf("%s:%d: %s is %lld, expected %lld\n", file, line, text, (long long) actual, (long long) expected);
+        testFailures++;
+    }
+}
+
+/**
+ * @brief Fails the test if the strings are not equal.
+ * @param expected Expected.
+ * @param actual Actual.
+ * @param file File.
+ * @param line Line.
+ */
+static inline void TestAssertString(const char* const expected, const char* const actual, const char* const file, const int line) {
+    if (strcmp(expected, actual) != 0) {
+        printf("%s:%d: \"%s\", expected \"%s\"\n", file, line, actual, expected);
+        testFailures++;
+    }
+}
+
+#endif
+
+//------------------------------------------------------------------------------
+// End of file
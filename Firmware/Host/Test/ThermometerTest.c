@@ -0,0 +1,243 @@
+/**
+ * @file ThermometerTest.c
+ * @author Seb Madgwick
+ * @brief Thermometer unit tests. The TMP117 is the model attached to the I2C2
+ * stand-in and the timer is simulated.
+ */
+
+//------------------------------------------------------------------------------
+// Includes
+
+#include "I2C/I2C2.h"
+#include "I2C/I2C2Host.h"
+#include <math.h>
+#include "Statistics/Statistics.h"
+#include <stdlib.h>
+#include "Test.h"
+#include "Thermometer/Thermometer.h"
+#include "Timer/Timer.h"
+#include "Tmp117/Tmp117.h"
+
+//------------------------------------------------------------------------------
+// Definitions
+
+#define I2C_ADDRESS (0x48)
+
+/**
+ * @brief Main loop period in timer ticks.
+ */
+#define LOOP_TICKS (100 * TIMER_TICKS_PER_MICROSECOND)
+
+/**
+ * @brief Fastest conversion period in timer ticks.
+ */
+#define FASTEST_PERIOD (15500 * TIMER_TICKS_PER_MICROSECOND)
+
+//------------------------------------------------------------------------------
+// Function declarations
+
+static int Run(const uint32_t milliseconds, ThermometerData * const latest);
+static uint16_t ReadRegister(const uint8_t address);
+static void WriteRegister(const uint8_t address, const uint16_t value);
+
+//------------------------------------------------------------------------------
+// Variables
+
+static uint64_t minimumInterval;
+static uint64_t maximumInterval;
+static int64_t minimumLatency;
+static int64_t maximumLatency;
+
+//------------------------------------------------------------------------------
+// Functions
+
+/**
+ * @brief Runs the tests.
+ */
+void ThermometerTest(void) {
+    TimerInitialise();
+    TimerSimulate(true);
+    I2C2HostDetachAll();
+    I2C2HostAttach(&tmp117Client);
+    Tmp117Initialise();
+    Tmp117SetEeprom(0xAAAA, 0x1234, 0x5678);
+    const ThermometerSettings fastest = ThermometerSettingsFromRate(INFINITY);
+    const ThermometerSettings slowest = {.conversionCycle = ThermometerConversionCycle1s, .averaging = ThermometerAveraging64};
+    ThermometerData data = {0};
+
+    // Initialisation configures continuous conversion with ALERT as data ready
+    ThermometerInitialise(&fastest);
+    StatisticsInitialise();
+    TEST_ASSERT_EQUAL(0x0117, ReadRegister(0x0F));
+    TEST_ASSERT_EQUAL(0x0004, ReadRegister(0x01) & 0x0FFC);
+    TEST_ASSERT_EQUAL(0x12345678, ThermometerReadUniqueId());
+
+    // Every conversion is read once at the conversion rate
+    Tmp117SetTemperature(25.0f);
+    uint32_t conversions = Tmp117GetNumberOfConversions();
+    int count = Run(1000, &data);
+    TEST_ASSERT(abs((int) (Tmp117GetNumberOfConversions() - conversions) - count) <= 1);
+    TEST_ASSERT((count >= 63) && (count <= 65));
+    TEST_ASSERT_EQUAL(3200, data.raw);
+    TEST_ASSERT((minimumInterval >= (FASTEST_PERIOD - (TIMER_TICKS_PER_MILLISECOND + LOOP_TICKS))) && (maximumInterval <= (FASTEST_PERIOD + TIMER_TICKS_PER_MILLISECOND + LOOP_TICKS)));
+
+    // Timestamp is not before the conversion result and is within a poll interval of it
+    TEST_ASSERT((minimumLatency >= 0) && (maximumLatency <= (TIMER_TICKS_PER_MILLISECOND + (3 * LOOP_TICKS))));
+
+    // Polls are paced by the conversion period and are serviced on time
+    const StatisticsLateness * const lateness = &StatisticsGet()->lateness[StatisticsEventThermometerPoll];
+    TEST_ASSERT(lateness->count < (uint32_t) (4 * count));
+    TEST_ASSERT(lateness->maximum <= LOOP_TICKS);
+
+    // Conversion timing tolerates TMP117 oscillator error
+    for (int index = 0; index < 2; index++) {
+        Tmp117SetClockError(index == 0 ? 50000.0f : -50000.0f);
+        Run(100, &data);
+        conversions = Tmp117GetNumberOfConversions();
+        count = Run(1000, &data);
+        TEST_ASSERT(abs((int) (Tmp117GetNumberOfConversions() - conversions) - count) <= 1);
+    }
+    Tmp117SetClockError(0.0f);
+
+    // Averaging is the mean of the conversions within the conversion period
+    Tmp117SetTemperature(20.0f);
+    ThermometerSetSettings(&slowest);
+    ThermometerRead(&data); // discard result of previous settings
+    TEST_ASSERT_EQUAL(0, Run(500, &data));
+    Tmp117SetTemperature(30.0f);
+    TEST_ASSERT_EQUAL(1, Run(600, &data));
+    TEST_ASSERT_EQUAL(3200, data.raw);
+    TEST_ASSERT_EQUAL(1, Run(1000, &data));
+    TEST_ASSERT_EQUAL(3840, data.raw);
+    TEST_ASSERT(ThermometerReadTemperature() == 30.0f);
+
+    // NACKs are not reported as data and polling resumes
+    ThermometerSetSettings(&fastest);
+    ThermometerRead(&data); // discard result of previous settings
+    Tmp117Nack(UINT32_MAX);
+    TEST_ASSERT_EQUAL(0, Run(100, &data));
+    Tmp117Nack(0);
+    TEST_ASSERT(Run(100, &data) >= 5);
+
+    // A stalled transfer times out and polling resumes
+    Tmp117Stall(1);
+    TEST_ASSERT(Run(100, &data) >= 5);
+    TEST_ASSERT(I2C2TransferInProgress() == false);
+
+    // A stalled blocking read times out
+    Tmp117Stall(2);
+    const uint64_t ticks = TimerGetTicks64();
+    TEST_ASSERT_EQUAL(0xFFFF5678, ThermometerReadUniqueId());
+    TEST_ASSERT(TimerGetTicks64() - ticks >= (2 * I2C_TIMEOUT(I2CClockFrequency400kHz)));
+
+    // ALERT pin indicates data ready and is cleared by reading
+    ThermometerSetSettings(&fastest);
+    TimerAdvance(FASTEST_PERIOD);
+    TEST_ASSERT(Tmp117GetAlert() == false);
+    ReadRegister(0x00);
+    TEST_ASSERT(Tmp117GetAlert());
+
+    // ALERT pin in alert mode is active high and latched until read
+    WriteRegister(0x02, 30 * 128);
+    WriteRegister(0x03, 28 * 128);
+    WriteRegister(0x01, 0x0008);
+    Tmp117SetTemperature(35.0f);
+    TimerAdvance(FASTEST_PERIOD);
+    TEST_ASSERT(Tmp117GetAlert());
+    Tmp117SetTemperature(25.0f);
+    TimerAdvance(FASTEST_PERIOD);
+    TEST_ASSERT(Tmp117GetAlert());
+    const uint16_t configuration = ReadRegister(0x01);
+    TEST_ASSERT_EQUAL(0xC000, configuration & 0xC000);
+    TEST_ASSERT(Tmp117GetAlert() == false);
+
+    // ALERT pin in therm mode has hysteresis and is not cleared by reading
+    WriteRegister(0x01, 0x0018);
+    Tmp117SetTemperature(35.0f);
+    TimerAdvance(FASTEST_PERIOD);
+    ReadRegister(0x01);
+    TEST_ASSERT(Tmp117GetAlert());
+    Tmp117SetTemperature(29.0f);
+    TimerAdvance(FASTEST_PERIOD);
+    TEST_ASSERT(Tmp117GetAlert());
+    Tmp117SetTemperature(27.0f);
+    TimerAdvance(FASTEST_PERIOD);
+    TEST_ASSERT(Tmp117GetAlert() == false);
+
+    // Invalid register address is NACKed
+    i2c2.start();
+    TEST_ASSERT(i2c2.sendAddressWrite(I2C_ADDRESS));
+    TEST_ASSERT(i2c2.send(0x09) == false);
+    i2c2.stop();
+
+    TimerSimulate(false);
+}
+
+/**
+ * @brief Runs the main loop for a period. The intervals between the data
+ * timestamps and the latency of each timestamp relative to the conversion
+ * result are recorded.
+ * @param milliseconds Period in milliseconds.
+ * @param latest Latest data.
+ * @return Number of data read.
+ */
+static int Run(const uint32_t milliseconds, ThermometerData * const latest) {
+    minimumInterval = UINT64_MAX;
+    maximumInterval = 0;
+    minimumLatency = INT64_MAX;
+    maximumLatency = INT64_MIN;
+    int count = 0;
+    const uint64_t end = TimerGetTicks64() + ((uint64_t) milliseconds * TIMER_TICKS_PER_MILLISECOND);
+    while (TimerGetTicks64() < end) {
+        ThermometerData data;
+        if (ThermometerRead(&data)) {
+            const int64_t latency = (int64_t) (data.ticks - Tmp117GetResultTicks());
+            minimumLatency = latency < minimumLatency ? latency : minimumLatency;
+            maximumLatency = latency > maximumLatency ? latency : maximumLatency;
+            if (count > 0) {
+                const uint64_t interval = data.ticks - latest->ticks;
+                minimumInterval = interval < minimumInterval ? interval : minimumInterval;
+                maximumInterval = interval > maximumInterval ? interval : maximumInterval;
+            }
+            *latest = data;
+            count++;
+        }
+        I2C2Tasks();
+        TimerAdvance(LOOP_TICKS);
+    }
+    return count;
+}
+
+/**
+ * @brief Reads a TMP117 register using the I2C interface.
+ * @param address Register address.
+ * @return Register value.
+ */
+static uint16_t ReadRegister(const uint8_t address) {
+    i2c2.start();
+    i2c2.sendAddressWrite(I2C_ADDRESS);
+    i2c2.send(address);
+    i2c2.repeatedStart();
+    i2c2.sendAddressRead(I2C_ADDRESS);
+    const uint8_t msb = i2c2.receive(true);
+    const uint8_t lsb = i2c2.receive(false);
+    i2c2.stop();
+    return ((uint16_t) msb << 8) | (uint16_t) lsb;
+}
+
+/**
+ * @brief Writes a TMP117 register using the I2C interface.
+ * @param address Register address.
+ * @param value Register value.
+ */
+static void WriteRegister(const uint8_t address, const uint16_t value) {
+    i2c2.start();
+    i2c2.sendAddressWrite(I2C_ADDRESS);
+    i2c2.send(address);
+    i2c2.send(value >> 8);
+    i2c2.send(value & 0xFF);
+    i2c2.stop();
+}
+
+//------------------------------------------------------------------------------
+// End of file
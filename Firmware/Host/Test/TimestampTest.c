@@ -0,0 +1,151 @@
+/**
+ * @file TimestampTest.c
+ * @author Seb Madgwick
+ * @brief Timestamp unit tests. The timer is simulated. The conversion of timer
+ * ticks to microseconds is compared bit for bit with the 64-bit division.
+ */
+
+//------------------------------------------------------------------------------
+// Includes
+
+#include "Test.h"
+#include "Timer/Timer.h"
+#include "Timestamp/Timestamp.h"
+
+//------------------------------------------------------------------------------
+// Definitions
+
+/**
+ * @brief Number of quotients either side of each power of two and of the
+ * maximum quotient swept exhaustively.
+ */
+#define BOUNDARY_SWEEP (4096)
+
+/**
+ * @brief Number of random ticks in the range [0, UINT64_MAX].
+ */
+#define NUMBER_OF_RANDOM_TICKS (10000000)
+
+//------------------------------------------------------------------------------
+// Function declarations
+
+static void CheckMicroseconds(const uint64_t ticks);
+static uint64_t Random(void);
+
+//------------------------------------------------------------------------------
+// Variables
+
+static uint64_t baseMicroseconds;
+static uint32_t numberOfMismatches;
+static uint32_t numberOfCorrections;
+static uint64_t randomState = 0x123456789ABCDEF0ULL;
+
+//------------------------------------------------------------------------------
+// Functions
+
+/**
+ * @brief Runs the tests.
+ */
+void TimestampTest(void) {
+    TimerInitialise();
+    TimerSimulate(true);
+
+    // Conversion is identical to the division for the correction boundaries
+    TimestampSet(0); // zero rate so that the timestamp is the microseconds since the base
+    baseMicroseconds = TimerGetTicks64() / TIMER_TICKS_PER_MICROSECOND;
+    for (uint64_t ticks = 0; ticks < (BOUNDARY_SWEEP * TIMER_TICKS_PER_MICROSECOND); ticks++) {
+        CheckMicroseconds(ticks);
+    }
+    for (int shift = 0; shift < 64; shift++) {
+        const uint64_t quotient = (1ULL << shift) / TIMER_TICKS_PER_MICROSECOND;
+        if (quotient < BOUNDARY_SWEEP) {
+            continue; // swept from zero
+        }
+        for (uint64_t offset = 0; offset < (2 * BOUNDARY_SWEEP); offset++) {
+            const uint64_t ticks = ((quotient - BOUNDARY_SWEEP) + offset) * TIMER_TICKS_PER_MICROSECOND;
+            CheckMicroseconds(ticks - 1);
+            CheckMicroseconds(ticks);
+        }
+    }
+    for (uint64_t ticks = UINT64_MAX - (BOUNDARY_SWEEP * TIMER_TICKS_PER_MICROSECOND); ticks != 0; ticks++) {
+        CheckMicroseconds(ticks);
+    }
+
+    // Conversion is identical to the division for random ticks
+    for (int index = 0; index < NUMBER_OF_RANDOM_TICKS; index++) {
+        const uint64_t ticks = Random();
+        CheckMicroseconds(ticks);
+        CheckMicroseconds(ticks - (ticks % TIMER_TICKS_PER_MICROSECOND)); // quotient boundary
+    }
+    TEST_ASSERT_EQUAL(0, numberOfMismatches);
+    TEST_ASSERT(numberOfCorrections > 0);
+
+    // Timestamp counts microseconds
+    TimestampSet(1000000);
+    TimerAdvance(TIMER_TICKS_PER_SECOND);
+    TEST_ASSERT_EQUAL(2000000, TimestampGet());
+    TEST_ASSERT_EQUAL(TimestampGet(), TimestampFrom(TimerGetTicks64()));
+
+    // First synchronisation steps
+    TimestampSynchronise(5000000000ULL);
+    TEST_ASSERT_EQUAL(5000000000ULL, TimestampGet());
+
+    // Timer 100 ppm slow is corrected and remains monotonic
+    uint64_t reference = 5000000000ULL;
+    uint64_t previous = TimestampGet();
+    bool monotonic = true;
+    for (int index = 0; index < 100; index++) {
+        for (int step = 0; step < 100; step++) {
+            TimerAdvance((TIMER_TICKS_PER_SECOND / 100) - (TIMER_TICKS_PER_SECOND / 1000000));
+            const uint64_t timestamp = TimestampGet();
+            if (timestamp < previous) {
+                monotonic = false;
+            }
+            previous = timestamp;
+        }
+        reference += 1000000;
+        TimestampSynchronise(reference);
+    }
+    TEST_ASSERT(monotonic);
+    const float skew = TimestampGetSkew();
+    TEST_ASSERT((skew > 90.0f) && (skew < 110.0f));
+    const int64_t residual = TimestampGetResidual();
+    TEST_ASSERT((residual > -10) && (residual < 10));
+
+    // Large error steps
+    TimestampSynchronise(reference + 10000000);
+    TEST_ASSERT_EQUAL(reference + 10000000, TimestampGet());
+
+    TimerSimulate(false);
+}
+
+/**
+ * @brief Compares the microseconds of the timer ticks with the 64-bit
+ * division. The number of ticks for which the reciprocal estimate is corrected
+ * is counted to confirm that the correction is tested.
+ * @param ticks Timer ticks.
+ */
+static void CheckMicroseconds(const uint64_t ticks) {
+    const uint64_t expected = ticks / TIMER_TICKS_PER_MICROSECOND;
+    if ((TimestampFrom(ticks) + baseMicroseconds) != expected) {
+        numberOfMismatches++;
+    }
+    const uint64_t estimate = (uint64_t) (((unsigned __int128) ticks * (UINT64_MAX / TIMER_TICKS_PER_MICROSECOND)) >> 64);
+    if (estimate != expected) {
+        numberOfCorrections++;
+    }
+}
+
+/**
+ * @brief Returns a random number.
+ * @return Random number.
+ */
+static uint64_t Random(void) {
+    randomState ^= randomState << 13;
+    randomState ^= randomState >> 7;
+    randomState ^= randomState << 17;
+    return randomState;
+}
+
+//------------------------------------------------------------------------------
+// End of file
@@ -0,0 +1,78 @@
+/**
+ * @file UsbCdcTest.c
+ * @author Seb Madgwick
+ * @brief USB CDC stand-in unit tests. Data is transferred through the
+ * pseudo-terminal in both directions.
+ */
+
+//------------------------------------------------------------------------------
+// Includes
+
+#include <fcntl.h>
+#include <poll.h>
+#include "Test.h"
+#include <unistd.h>
+#include "Usb/UsbCdc.h"
+#include "Usb/UsbCdcHost.h"
+
+//------------------------------------------------------------------------------
+// Definitions
+
+/**
+ * @brief Number of attempts to transfer data through the pseudo-terminal.
+ */
+#define NUMBER_OF_ATTEMPTS (100)
+
+//------------------------------------------------------------------------------
+// Functions
+
+/**
+ * @brief Runs the tests.
+ */
+void UsbCdcTest(void) {
+    UsbCdcHostClear();
+
+    // All byte values are received unmodified
+    const char* const name = UsbCdcHostOpenPty();
+    TEST_ASSERT(name != NULL);
+    if (name == NULL) {
+        return;
+    }
+    const int port = open(name, O_RDWR | O_NOCTTY | O_NONBLOCK);
+    TEST_ASSERT(port >= 0);
+    uint8_t data[256];
+    for (size_t index = 0; index < sizeof (data); index++) {
+        data[index] = (uint8_t) index;
+    }
+    TEST_ASSERT_EQUAL(sizeof (data), write(port, data, sizeof (data)));
+    uint8_t received[sizeof (data)];
+    size_t numberOfBytes = 0;
+    for (int attempt = 0; (attempt < NUMBER_OF_ATTEMPTS) && (numberOfBytes < sizeof (received)); attempt++) {
+        usleep(1000);
+        UsbCdcTasks();
+        numberOfBytes += UsbCdcRead(&received[numberOfBytes], sizeof (received) - numberOfBytes);
+    }
+    TEST_ASSERT_EQUAL(sizeof (data), numberOfBytes);
+    TEST_ASSERT_MEMORY(data, received, sizeof (data));
+
+    // All byte values are sent unmodified
+    TEST_ASSERT(UsbCdcWrite(data, sizeof (data)) == FifoResultOk);
+    numberOfBytes = 0;
+    for (int attempt = 0; (attempt < NUMBER_OF_ATTEMPTS) && (numberOfBytes < sizeof (received)); attempt++) {
+        UsbCdcTasks();
+        struct pollfd pollfd = {.fd = port, .events = POLLIN};
+        if (poll(&pollfd, 1, 1) > 0) {
+            const ssize_t numberOfBytesRead = read(port, &received[numberOfBytes], sizeof (received) - numberOfBytes);
+            numberOfBytes += numberOfBytesRead > 0 ? (size_t) numberOfBytesRead : 0;
+        }
+    }
+    TEST_ASSERT_EQUAL(sizeof (data), numberOfBytes);
+    TEST_ASSERT_MEMORY(data, received, sizeof (data));
+    TEST_ASSERT_EQUAL(0, UsbCdcReadBufferOverflow());
+
+    close(port);
+    UsbCdcHostClosePty();
+}
+
+//------------------------------------------------------------------------------
+// End of file
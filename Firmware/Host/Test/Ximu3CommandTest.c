@@ -0,0 +1,164 @@
+/**
+ * @file Ximu3CommandTest.c
+ * @author Seb Madgwick
+ * @brief x-IMU3 command unit tests. Commands are sent and responses received
+ * through the USB CDC stand-in.
+ */
+
+//------------------------------------------------------------------------------
+// Includes
+
+#include "Test.h"
+#include "Usb/UsbCdc.h"
+#include "Usb/UsbCdcHost.h"
+#include "x-IMU3-Device/Ximu3.h"
+
+//------------------------------------------------------------------------------
+// Function declarations
+
+static size_t Read(void* const destination, size_t numberOfBytes, void* const context);
+static void Write(const void* const data, const size_t numberOfBytes, void* const context);
+static void ReadPointer(void* * const pointer, size_t * const numberOfBytes, void* const context);
+static void ReadPointerComplete(const size_t numberOfBytes, void* const context);
+static void Echo(const char* * const value, Ximu3CommandResponse * const response, void* const context);
+static const char* Command(Ximu3CommandBridge * const bridge, const char* const command);
+
+//------------------------------------------------------------------------------
+// Variables
+
+static Ximu3CommandInterface bufferedInterfaces[] = {
+    { .name = "USB", .read = Read, .write = Write},
+};
+
+static Ximu3CommandInterface inPlaceInterfaces[] = {
+    { .name = "USB", .read = Read, .write = Write, .readPointer = ReadPointer, .readPointerComplete = ReadPointerComplete},
+};
+
+static const Ximu3CommandMap commands[] = {
+    {"echo", Echo},
+};
+
+static Ximu3Settings settings;
+
+static Ximu3CommandBridge bufferedBridge = {
+    .interfaces = bufferedInterfaces,
+    .numberOfInterfaces = sizeof (bufferedInterfaces) / sizeof (Ximu3CommandInterface),
+    .commands = commands,
+    .numberOfCommands = sizeof (commands) / sizeof (Ximu3CommandMap),
+    .settings = &settings,
+};
+
+static Ximu3CommandBridge inPlaceBridge = {
+    .interfaces = inPlaceInterfaces,
+    .numberOfInterfaces = sizeof (inPlaceInterfaces) / sizeof (Ximu3CommandInterface),
+    .commands = commands,
+    .numberOfCommands = sizeof (commands) / sizeof (Ximu3CommandMap),
+    .settings = &settings,
+};
+
+//------------------------------------------------------------------------------
+// Functions
+
+/**
+ * @brief Runs the tests.
+ */
+void Ximu3CommandTest(void) {
+    Ximu3SettingsInitialise(&settings);
+    Ximu3SettingsLoadDefaults(&settings, true);
+    UsbCdcHostClear();
+
+    Ximu3CommandBridge * const bridges[] = {&bufferedBridge, &inPlaceBridge};
+    for (size_t index = 0; index < (sizeof (bridges) / sizeof (bridges[0])); index++) {
+        Ximu3CommandBridge * const bridge = bridges[index];
+
+        // Command
+        TEST_ASSERT_STRING("{\"echo\":\"abc\"}\n", Command(bridge, "{\"echo\":\"abc\"}\n"));
+        TEST_ASSERT_STRING("{\"echo\":{\"error\":\"Unexpected type\"}}\n", Command(bridge, "{\"echo\":1}\n"));
+
+        // Settings
+        TEST_ASSERT_STRING("{\"binary_mode_enabled\":true}\n", Command(bridge, "{\"binary_mode_enabled\":true}\n"));
+        TEST_ASSERT(Ximu3SettingsGet(&settings)->binaryModeEnabled);
+        TEST_ASSERT_STRING("{\"binary_mode_enabled\":true}\n", Command(bridge, "{\"binary_mode_enabled\":null}\n"));
+        TEST_ASSERT_STRING("{\"binary_mode_enabled\":false}\n", Command(bridge, "{\"binary_mode_enabled\":false}\n"));
+
+        // Messages split across reads
+        TEST_ASSERT_STRING("", Command(bridge, "{\"echo\""));
+        TEST_ASSERT_STRING("{\"echo\":\"split\"}\n", Command(bridge, ":\"split\"}\n"));
+
+        // Several messages in one read
+        TEST_ASSERT_STRING("{\"echo\":\"a\"}\n{\"echo\":\"b\"}\n", Command(bridge, "{\"echo\":\"a\"}\n{\"echo\":\"b\"}\n"));
+    }
+}
+
+/**
+ * @brief Reads data from the USB CDC stand-in.
+ * @param destination Destination.
+ * @param numberOfBytes Number of bytes.
+ * @param context Context.
+ * @return Number of bytes read.
+ */
+static size_t Read(void* const destination, size_t numberOfBytes, void* const context) {
+    return UsbCdcRead(destination, numberOfBytes);
+}
+
+/**
+ * @brief Writes data to the USB CDC stand-in.
+ * @param data Data.
+ * @param numberOfBytes Number of bytes.
+ * @param context Context.
+ */
+static void Write(const void* const data, const size_t numberOfBytes, void* const context) {
+    UsbCdcWrite(data, numberOfBytes);
+}
+
+/**
+ * @brief Provides a pointer to the next contiguous block of data in the read
+ * buffer of the USB CDC stand-in.
+ * @param pointer Pointer.
+ * @param numberOfBytes Number of bytes.
+ * @param context Context.
+ */
+static void ReadPointer(void* * const pointer, size_t * const numberOfBytes, void* const context) {
+    UsbCdcReadPointer(pointer, numberOfBytes);
+}
+
+/**
+ * @brief Updates the read buffer after ReadPointer.
+ * @param numberOfBytes Number of bytes.
+ * @param context Context.
+ */
+static void ReadPointerComplete(const size_t numberOfBytes, void* const context) {
+    UsbCdcReadPointerComplete(numberOfBytes);
+}
+
+/**
+ * @brief Echo command. Responds with the string value.
+ * @param value Value.
+ * @param response Response.
+ * @param context Context.
+ */
+static void Echo(const char* * const value, Ximu3CommandResponse * const response, void* const context) {
+    char string[32];
+    if (Ximu3CommandParseString(value, response, string, sizeof (string), NULL) != Ximu3ResultOk) {
+        return;
+    }
+    snprintf(response->value, sizeof (response->value), "\"%s\"", string);
+    Ximu3CommandRespond(response);
+}
+
+/**
+ * @brief Sends a command and returns the response.
+ * @param bridge Bridge.
+ * @param command Command.
+ * @return Response.
+ */
+static const char* Command(Ximu3CommandBridge * const bridge, const char* const command) {
+    static char response[256];
+    UsbCdcHostSend(command, strlen(command));
+    Ximu3CommandTasks(bridge);
+    response[UsbCdcHostReceive(response, sizeof (response) - 1)] = '\0';
+    return response;
+}
+
+//------------------------------------------------------------------------------
+// End of file
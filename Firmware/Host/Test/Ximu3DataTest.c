@@ -0,0 +1,311 @@
+/**
+ * @file Ximu3DataTest.c
+ * @author Seb Madgwick
+ * @brief x-IMU3 data message unit tests. The ASCII number formatting is
+ * compared with snprintf and the binary messages are compared with a byte-wise
+ * reference encoder.
+ */
+
+//------------------------------------------------------------------------------
+// Includes
+
+#include <inttypes.h>
+#include "Test.h"
+#include "x-IMU3-Device/Ascii.h"
+#include "x-IMU3-Device/Ximu3.h"
+
+//------------------------------------------------------------------------------
+// Definitions
+
+/**
+ * @brief Number of random float bit patterns.
+ */
+#define NUMBER_OF_RANDOM_FLOATS (4000000)
+
+/**
+ * @brief Number of random unsigned integers.
+ */
+#define NUMBER_OF_RANDOM_UNSIGNED (1000000)
+
+/**
+ * @brief Number of random binary messages of each type.
+ */
+#define NUMBER_OF_RANDOM_MESSAGES (100000)
+
+//------------------------------------------------------------------------------
+// Function declarations
+
+static bool FloatMatches(const uint32_t bits);
+static bool UnsignedMatches(const uint64_t value);
+static void RandomBytes(void* const data, const size_t numberOfBytes);
+static size_t Payload(uint8_t * const payload, const char character, const uint64_t timestamp, const void* const values, const size_t numberOfBytes);
+static bool BinaryMatches(const uint8_t * const payload, const size_t payloadSize, const uint8_t * const actual, const size_t actualSize);
+static uint64_t Random(void);
+
+//------------------------------------------------------------------------------
+// Variables
+
+static uint64_t randomState = 0x0123456789ABCDEFULL;
+
+//------------------------------------------------------------------------------
+// Functions
+
+/**
+ * @brief Runs the tests.
+ */
+void Ximu3DataTest(void) {
+    char expected[256];
+    char actual[256];
+
+    // Floats are identical to "%.4f" for special values
+    const uint32_t specialFloats[] = {
+        0x7FC00000, 0xFFC00000, 0x7F800001, 0xFFFFFFFF, // NaN
+        0x7F800000, 0xFF800000, // infinity
+        0x00000000, 0x80000000, // zero
+        0x00000001, 0x80000001, 0x007FFFFF, 0x807FFFFF, 0x00400000, // subnormal
+        0x00800000, 0x80800000, // smallest normal
+        0x7F7FFFFF, 0xFF7FFFFF, 0x7F000000, 0x5F800000, 0x4F800000, 0x4B800000, 0x4B7FFFFF, // large exponents
+        0x38D1B717, 0x38D1B718, 0x3851B717, 0x3851B718, // around 0.0001 and 0.00005
+    };
+    bool floatMatch = true;
+    for (size_t index = 0; index < (sizeof (specialFloats) / sizeof (specialFloats[0])); index++) {
+        floatMatch &= FloatMatches(specialFloats[index]);
+    }
+    TEST_ASSERT(floatMatch);
+
+    // Floats are identical to "%.4f" for ties, which are the odd multiples of 1/32
+    floatMatch = true;
+    for (int32_t numerator = 1; numerator < (1 << 24); numerator += 2) {
+        const float value = (float) numerator / 32.0f;
+        uint32_t bits;
+        memcpy(&bits, &value, sizeof (bits));
+        floatMatch &= FloatMatches(bits);
+        floatMatch &= FloatMatches(bits | 0x80000000);
+    }
+    TEST_ASSERT(floatMatch);
+
+    // Floats are identical to "%.4f" for random bit patterns
+    floatMatch = true;
+    for (int index = 0; index < NUMBER_OF_RANDOM_FLOATS; index++) {
+        floatMatch &= FloatMatches((uint32_t) Random());
+    }
+    TEST_ASSERT(floatMatch);
+
+    // Unsigned integers are identical to PRIu64
+    const uint64_t specialUnsigned[] = {0, 1, 9, 10, 999999999, 1000000000, 1000000001, 999999999999999999ULL, 1000000000000000000ULL, UINT32_MAX, (uint64_t) UINT32_MAX + 1, UINT64_MAX - 1, UINT64_MAX};
+    bool unsignedMatch = true;
+    for (size_t index = 0; index < (sizeof (specialUnsigned) / sizeof (specialUnsigned[0])); index++) {
+        unsignedMatch &= UnsignedMatches(specialUnsigned[index]);
+    }
+    for (int index = 0; index < NUMBER_OF_RANDOM_UNSIGNED; index++) {
+        const uint64_t value = Random();
+        unsignedMatch &= UnsignedMatches(value);
+        unsignedMatch &= UnsignedMatches(value >> (value % 64));
+    }
+    TEST_ASSERT(unsignedMatch);
+
+    // ASCII message
+    const Ximu3DataTemperature temperature = {.timestamp = 123456789, .temperature = 25.5f};
+    size_t size = Ximu3DataTemperatureAscii(actual, sizeof (actual), &temperature);
+    actual[size] = '\0';
+    TEST_ASSERT_STRING("T,123456789,25.5000\n", actual);
+
+    // Fixed-point messages are identical to floating-point messages for every raw temperature
+    bool asciiMatch = true;
+    bool binaryMatch = true;
+    for (int32_t raw = INT16_MIN; raw <= INT16_MAX; raw++) {
+        const Ximu3DataTemperature floatData = {.timestamp = (uint64_t) raw * 1000003, .temperature = (float) raw / 128.0f};
+        const Ximu3DataTemperatureFixed fixedData = {.timestamp = floatData.timestamp, .temperature = (int16_t) raw};
+        size_t expectedSize = Ximu3DataTemperatureAscii(expected, sizeof (expected), &floatData);
+        size_t actualSize = Ximu3DataTemperatureFixedAscii(actual, sizeof (actual), &fixedData);
+        if ((expectedSize != actualSize) || (memcmp(expected, actual, actualSize) != 0)) {
+            asciiMatch = false;
+        }
+        expectedSize = Ximu3DataTemperatureBinary(expected, sizeof (expected), &floatData);
+        actualSize = Ximu3DataTemperatureFixedBinary(actual, sizeof (actual), &fixedData);
+        if ((expectedSize != actualSize) || (memcmp(expected, actual, actualSize) != 0)) {
+            binaryMatch = false;
+        }
+    }
+    TEST_ASSERT(asciiMatch);
+    TEST_ASSERT(binaryMatch);
+
+    // Destination too small returns size not less than destination size
+    const Ximu3DataTemperatureFixed fixedData = {.timestamp = UINT64_MAX, .temperature = INT16_MIN};
+    const size_t messageSize = Ximu3DataTemperatureFixedAscii(expected, sizeof (expected), &fixedData);
+    bool truncated = true;
+    for (size_t destinationSize = 0; destinationSize <= messageSize; destinationSize++) {
+        memset(actual, 0x55, sizeof (actual));
+        if (Ximu3DataTemperatureFixedAscii(actual, destinationSize, &fixedData) < destinationSize) {
+            truncated = false;
+        }
+        if (actual[destinationSize] != 0x55) {
+            truncated = false;
+        }
+    }
+    TEST_ASSERT(truncated);
+    TEST_ASSERT(Ximu3DataTemperatureFixedBinary(actual, 1, &fixedData) >= 1);
+
+    // Binary messages are identical to the byte-wise reference for random data biased towards the stuffed bytes at unaligned destinations
+    uint8_t buffer[256 + 8];
+    uint8_t payload[256];
+    bool binaryReferenceMatch = true;
+    for (int index = 0; index < NUMBER_OF_RANDOM_MESSAGES; index++) {
+        uint8_t * const destination = &buffer[index % 8];
+        const size_t destinationSize = sizeof (buffer) - 8;
+
+        // Inertial
+        Ximu3DataInertial inertial;
+        RandomBytes(&inertial, sizeof (inertial));
+        memset(buffer, 0x55, sizeof (buffer));
+        size_t payloadSize = Payload(payload, 'I', inertial.timestamp, &inertial.gyroscopeX, 6 * sizeof (float));
+        binaryReferenceMatch &= BinaryMatches(payload, payloadSize, destination, Ximu3DataInertialBinary(destination, destinationSize, &inertial));
+
+        // Magnetometer
+        Ximu3DataMagnetometer magnetometer;
+        RandomBytes(&magnetometer, sizeof (magnetometer));
+        memset(buffer, 0x55, sizeof (buffer));
+        payloadSize = Payload(payload, 'M', magnetometer.timestamp, &magnetometer.x, 3 * sizeof (float));
+        binaryReferenceMatch &= BinaryMatches(payload, payloadSize, destination, Ximu3DataMagnetometerBinary(destination, destinationSize, &magnetometer));
+
+        // Temperature
+        Ximu3DataTemperature temperature;
+        RandomBytes(&temperature, sizeof (temperature));
+        memset(buffer, 0x55, sizeof (buffer));
+        payloadSize = Payload(payload, 'T', temperature.timestamp, &temperature.temperature, sizeof (float));
+        binaryReferenceMatch &= BinaryMatches(payload, payloadSize, destination, Ximu3DataTemperatureBinary(destination, destinationSize, &temperature));
+
+        // Notification
+        char string[64];
+        const size_t length = Random() % sizeof (string);
+        RandomBytes(string, length);
+        for (size_t character = 0; character < length; character++) {
+            string[character] = string[character] == '\0' ? ' ' : string[character];
+        }
+        string[length] = '\0';
+        Ximu3DataNotification notification = {.string = string};
+        RandomBytes(&notification.timestamp, sizeof (notification.timestamp));
+        memset(buffer, 0x55, sizeof (buffer));
+        payloadSize = Payload(payload, 'N', notification.timestamp, string, length);
+        binaryReferenceMatch &= BinaryMatches(payload, payloadSize, destination, Ximu3DataNotificationBinary(destination, destinationSize, &notification));
+    }
+    TEST_ASSERT(binaryReferenceMatch);
+}
+
+/**
+ * @brief Returns true if AsciiFloat is identical to "%.4f" for a float.
+ * @param bits Float bit pattern.
+ * @return True if identical.
+ */
+static bool FloatMatches(const uint32_t bits) {
+    float value;
+    memcpy(&value, &bits, sizeof (value));
+    char expected[64];
+    const int expectedSize = snprintf(expected, sizeof (expected), ",%.4f", (double) value);
+    char actual[64];
+    size_t actualSize = 0;
+    AsciiFloat(actual, sizeof (actual), &actualSize, value);
+    if ((expectedSize != (int) actualSize) || (memcmp(expected, actual, actualSize) != 0)) {
+        printf("%08" PRIX32 ": %s != %.*s\n", bits, expected, (int) actualSize, actual);
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Returns true if AsciiUnsigned is identical to PRIu64 for a value.
+ * @param value Value.
+ * @return True if identical.
+ */
+static bool UnsignedMatches(const uint64_t value) {
+    char expected[32];
+    const int expectedSize = snprintf(expected, sizeof (expected), "%" PRIu64, value);
+    char actual[32];
+    size_t actualSize = 0;
+    AsciiUnsigned(actual, sizeof (actual), &actualSize, value);
+    if ((expectedSize != (int) actualSize) || (memcmp(expected, actual, actualSize) != 0)) {
+        printf("%" PRIu64 " != %.*s\n", value, (int) actualSize, actual);
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Writes random bytes. Half of the bytes are the end, escape, escaped
+ * end or escaped escape bytes.
+ * @param data Data.
+ * @param numberOfBytes Number of bytes.
+ */
+static void RandomBytes(void* const data, const size_t numberOfBytes) {
+    static const uint8_t stuffedBytes[] = {0x0A, 0xDB, 0xDC, 0xDD};
+    for (size_t index = 0; index < numberOfBytes; index++) {
+        const uint64_t random = Random();
+        ((uint8_t*) data)[index] = (random & 1) != 0 ? stuffedBytes[(random >> 1) & 3] : (uint8_t) (random >> 8);
+    }
+}
+
+/**
+ * @brief Writes the bytes of a binary message before byte stuffing. The
+ * timestamp is little-endian and the values are copied as stored, which is
+ * little-endian on the host.
+ * @param payload Payload.
+ * @param character First character of equivalent ASCII data message.
+ * @param timestamp Timestamp.
+ * @param values Values.
+ * @param numberOfBytes Number of bytes of the values.
+ * @return Payload size.
+ */
+static size_t Payload(uint8_t * const payload, const char character, const uint64_t timestamp, const void* const values, const size_t numberOfBytes) {
+    payload[0] = 0x80 + character;
+    for (int index = 0; index < 8; index++) {
+        payload[1 + index] = (uint8_t) (timestamp >> (8 * index));
+    }
+    memcpy(&payload[9], values, numberOfBytes);
+    return 9 + numberOfBytes;
+}
+
+/**
+ * @brief Returns true if a binary message is identical to the payload byte
+ * stuffed one byte at a time and terminated, and the byte after the message is
+ * not written.
+ * @param payload Payload.
+ * @param payloadSize Payload size.
+ * @param actual Binary message.
+ * @param actualSize Binary message size.
+ * @return True if identical.
+ */
+static bool BinaryMatches(const uint8_t * const payload, const size_t payloadSize, const uint8_t * const actual, const size_t actualSize) {
+    uint8_t expected[(2 * 256) + 1];
+    size_t expectedSize = 0;
+    for (size_t index = 0; index < payloadSize; index++) {
+        switch (payload[index]) {
+            case 0x0A:
+                expected[expectedSize++] = 0xDB;
+                expected[expectedSize++] = 0xDC;
+                break;
+            case 0xDB:
+                expected[expectedSize++] = 0xDB;
+                expected[expectedSize++] = 0xDD;
+                break;
+            default:
+                expected[expectedSize++] = payload[index];
+                break;
+        }
+    }
+    expected[expectedSize++] = 0x0A;
+    return (expectedSize == actualSize) && (memcmp(expected, actual, actualSize) == 0) && (actual[actualSize] == 0x55);
+}
+
+/**
+ * @brief Returns a random number.
+ * @return Random number.
+ */
+static uint64_t Random(void) {
+    randomState ^= randomState << 13;
+    randomState ^= randomState >> 7;
+    randomState ^= randomState << 17;
+    return randomState;
+}
+
+//------------------------------------------------------------------------------
+// End of file
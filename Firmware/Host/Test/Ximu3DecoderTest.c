@@ -0,0 +1,356 @@
+/**
+ * @file Ximu3DecoderTest.c
+ * @author Seb Madgwick
+ * @brief x-IMU3 decoder round-trip tests. Random messages of every type are
+ * encoded by Ximu3Data.c, decoded, and encoded again. Binary messages must
+ * decode to identical values and ASCII messages must encode to identical
+ * strings.
+ */
+
+//------------------------------------------------------------------------------
+// Includes
+
+#include "Test.h"
+#include "x-IMU3-Device/Binary.h"
+#include "Ximu3Decoder/Ximu3Decoder.h"
+
+//------------------------------------------------------------------------------
+// Definitions
+
+/**
+ * @brief Number of random messages of each type.
+ */
+#define NUMBER_OF_MESSAGES (2000)
+
+/**
+ * @brief Buffer size for an encoded message.
+ */
+#define MESSAGE_SIZE (XIMU3_DECODER_MAXIMUM_MESSAGE_SIZE)
+
+/**
+ * @brief Stream test context.
+ */
+typedef struct {
+    const uint8_t* expected;
+    size_t expectedSize;
+    size_t expectedIndex;
+    int numberOfMessages;
+    int numberOfErrors;
+    bool match;
+} StreamContext;
+
+//------------------------------------------------------------------------------
+// Function declarations
+
+static uint32_t Random(void);
+static float RandomFloat(const bool printable);
+static void RandomMessage(const Ximu3DecoderType type, const bool binary, Ximu3DecoderMessage * const message);
+static size_t Encode(const Ximu3DecoderMessage * const message, const bool binary, void* const destination, const size_t destinationSize);
+static void StreamMessage(const Ximu3DecoderMessage * const message, void* const context);
+static void StreamError(const Ximu3DecoderResult result, void* const context);
+
+//------------------------------------------------------------------------------
+// Variables
+
+static uint32_t randomState = 0x12345678;
+
+//------------------------------------------------------------------------------
+// Functions
+
+/**
+ * @brief Runs the tests.
+ */
+void Ximu3DecoderTest(void) {
+    static Ximu3DecoderMessage original;
+    static Ximu3DecoderMessage decoded;
+    uint8_t encoded[MESSAGE_SIZE];
+    uint8_t reencoded[MESSAGE_SIZE];
+
+    // Round trip every type
+    for (Ximu3DecoderType type = Ximu3DecoderTypeInertial; type <= Ximu3DecoderTypeError; type++) {
+        bool binaryMatch = true;
+        bool asciiMatch = true;
+        bool crossMatch = true;
+        for (int index = 0; index < NUMBER_OF_MESSAGES; index++) {
+
+            // Binary values are identical
+            RandomMessage(type, true, &original);
+            size_t size = Encode(&original, true, encoded, sizeof (encoded));
+            if ((Ximu3DecoderParse(encoded, size, &decoded) != Ximu3DecoderResultOk) || (decoded.type != type) || (decoded.binary == false)) {
+                binaryMatch = false;
+                continue;
+            }
+            size_t reencodedSize = Encode(&decoded, true, reencoded, sizeof (reencoded));
+            if ((reencodedSize != size) || (memcmp(encoded, reencoded, size) != 0)) {
+                binaryMatch = false;
+            }
+
+            // Binary and ASCII of the same values decode to the same ASCII
+            if ((type != Ximu3DecoderTypeNotification) && (type != Ximu3DecoderTypeError)) {
+                size = Encode(&original, false, encoded, sizeof (encoded));
+                reencodedSize = Encode(&decoded, false, reencoded, sizeof (reencoded));
+                if ((reencodedSize != size) || (memcmp(encoded, reencoded, size) != 0)) {
+                    crossMatch = false;
+                }
+            }
+
+            // ASCII strings are identical
+            RandomMessage(type, false, &original);
+            size = Encode(&original, false, encoded, sizeof (encoded));
+            if ((Ximu3DecoderParse(encoded, size, &decoded) != Ximu3DecoderResultOk) || (decoded.type != type) || decoded.binary) {
+                asciiMatch = false;
+                continue;
+            }
+            reencodedSize = Encode(&decoded, false, reencoded, sizeof (reencoded));
+            if ((reencodedSize != size) || (memcmp(encoded, reencoded, size) != 0)) {
+                asciiMatch = false;
+            }
+        }
+        TEST_ASSERT(binaryMatch);
+        TEST_ASSERT(asciiMatch);
+        TEST_ASSERT(crossMatch);
+    }
+
+    // Field extraction
+    const char inertial[] = "I,123,1.0000,2.0000,3.0000,-4.0000,5.5000,nan\n";
+    TEST_ASSERT_EQUAL(Ximu3DecoderResultOk, Ximu3DecoderParse(inertial, sizeof (inertial) - 1, &decoded));
+    TEST_ASSERT_EQUAL(Ximu3DecoderTypeInertial, decoded.type);
+    TEST_ASSERT_EQUAL(123, decoded.data.inertial.timestamp);
+    TEST_ASSERT(decoded.data.inertial.gyroscopeY == 2.0f);
+    TEST_ASSERT(decoded.data.inertial.accelerometerX == -4.0f);
+    TEST_ASSERT(decoded.data.inertial.accelerometerY == 5.5f);
+    TEST_ASSERT(decoded.data.inertial.accelerometerZ != decoded.data.inertial.accelerometerZ);
+    const char notification[] = "N,5,Hello, world\n";
+    TEST_ASSERT_EQUAL(Ximu3DecoderResultOk, Ximu3DecoderParse(notification, sizeof (notification) - 1, &decoded));
+    TEST_ASSERT_STRING("Hello, world", decoded.data.notification.string);
+    const char command[] = "{\"ping\":null}\n";
+    TEST_ASSERT_EQUAL(Ximu3DecoderResultOk, Ximu3DecoderParse(command, sizeof (command) - 1, &decoded));
+    TEST_ASSERT_EQUAL(Ximu3DecoderTypeCommand, decoded.type);
+    TEST_ASSERT_STRING("{\"ping\":null}", decoded.data.command);
+
+    // Invalid messages
+    TEST_ASSERT_EQUAL(Ximu3DecoderResultInvalidSize, Ximu3DecoderParse("\n", 1, &decoded));
+    TEST_ASSERT_EQUAL(Ximu3DecoderResultUnknownType, Ximu3DecoderParse("Z,1\n", 4, &decoded));
+    TEST_ASSERT_EQUAL(Ximu3DecoderResultInvalidNumber, Ximu3DecoderParse("T,x,1.0\n", 8, &decoded));
+    TEST_ASSERT_EQUAL(Ximu3DecoderResultInvalidNumber, Ximu3DecoderParse("T,1,x\n", 6, &decoded));
+    TEST_ASSERT_EQUAL(Ximu3DecoderResultInvalidSize, Ximu3DecoderParse("T,1\n", 4, &decoded));
+    TEST_ASSERT_EQUAL(Ximu3DecoderResultInvalidSize, Ximu3DecoderParse("T,1,1.0,2.0\n", 12, &decoded));
+    const uint8_t invalidEscape[] = {0x80 + 'T', BYTE_STUFFING_ESC, 0x00, '\n'};
+    TEST_ASSERT_EQUAL(Ximu3DecoderResultInvalidEscape, Ximu3DecoderParse(invalidEscape, sizeof (invalidEscape), &decoded));
+    const uint8_t truncated[] = {0x80 + 'T', 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, '\n'};
+    TEST_ASSERT_EQUAL(Ximu3DecoderResultInvalidSize, Ximu3DecoderParse(truncated, sizeof (truncated), &decoded));
+
+    // Stream of mixed messages and errors split into random chunks
+    static uint8_t stream[256 * MESSAGE_SIZE];
+    static uint8_t expected[256 * MESSAGE_SIZE];
+    size_t streamSize = 0;
+    size_t expectedSize = 0;
+    int numberOfMessages = 0;
+    for (int index = 0; index < 256; index++) {
+        const bool binary = (Random() & 1) != 0;
+        RandomMessage((Ximu3DecoderType) (Random() % (Ximu3DecoderTypeError + 1)), binary, &original);
+        const size_t size = Encode(&original, binary, &stream[streamSize], MESSAGE_SIZE);
+        memcpy(&expected[expectedSize], &stream[streamSize], size);
+        streamSize += size;
+        expectedSize += size;
+        numberOfMessages++;
+        if ((index % 64) == 0) {
+            memcpy(&stream[streamSize], "Z\n", 2);
+            streamSize += 2;
+        }
+    }
+    memset(&stream[streamSize], 'x', MESSAGE_SIZE);
+    streamSize += MESSAGE_SIZE;
+    stream[streamSize++] = '\n';
+    for (int repeat = 0; repeat < 16; repeat++) {
+        StreamContext context = {.expected = expected, .expectedSize = expectedSize, .match = true};
+        Ximu3Decoder decoder = {.message = StreamMessage, .error = StreamError, .context = &context};
+        size_t index = 0;
+        while (index < streamSize) {
+            size_t chunkSize = repeat == 0 ? 1 : (Random() % 300);
+            if (chunkSize > (streamSize - index)) {
+                chunkSize = streamSize - index;
+            }
+            Ximu3DecoderProcess(&decoder, &stream[index], chunkSize);
+            index += chunkSize;
+        }
+        TEST_ASSERT(context.match);
+        TEST_ASSERT_EQUAL(numberOfMessages, context.numberOfMessages);
+        TEST_ASSERT_EQUAL(5, context.numberOfErrors);
+        TEST_ASSERT_EQUAL(expectedSize, context.expectedIndex);
+    }
+}
+
+/**
+ * @brief Returns a random number.
+ * @return Random number.
+ */
+static uint32_t Random(void) {
+    randomState ^= randomState << 13;
+    randomState ^= randomState >> 17;
+    randomState ^= randomState << 5;
+    return randomState;
+}
+
+/**
+ * @brief Returns a random float. Non-printable floats have random bits and
+ * include NaN, infinity, subnormal values and values that require byte
+ * stuffing.
+ * @param printable True to limit the range to typical sensor values.
+ * @return Random float.
+ */
+static float RandomFloat(const bool printable) {
+    if (printable && ((Random() % 4) != 0)) {
+        return ((float) (int32_t) Random() / (float) INT32_MAX) * 2000.0f;
+    }
+    const uint32_t value = (Random() % 8) == 0 ? (0x0A0ADBDB ^ (Random() & 0x01000100)) : Random();
+    float result;
+    memcpy(&result, &value, sizeof (result));
+    return result;
+}
+
+/**
+ * @brief Creates a random message.
+ * @param type Type.
+ * @param binary True if the message is to be encoded as binary.
+ * @param message Message.
+ */
+static void RandomMessage(const Ximu3DecoderType type, const bool binary, Ximu3DecoderMessage * const message) {
+    message->type = type;
+    const uint64_t timestamp = ((uint64_t) Random() << 32) | Random();
+    float floats[9];
+    for (int index = 0; index < 9; index++) {
+        floats[index] = RandomFloat(binary == false);
+    }
+    const size_t numberOfBytes = Random() % 200;
+    for (size_t index = 0; index < numberOfBytes; index++) {
+        message->buffer[index] = binary ? (char) ((Random() % 255) + 1) : (char) ((Random() % 95) + ' ');
+    }
+    message->buffer[numberOfBytes] = '\0';
+    switch (type) {
+        case Ximu3DecoderTypeInertial:
+            message->data.inertial = (Ximu3DataInertial){timestamp, floats[0], floats[1], floats[2], floats[3], floats[4], floats[5]};
+            break;
+        case Ximu3DecoderTypeMagnetometer:
+            message->data.magnetometer = (Ximu3DataMagnetometer){timestamp, floats[0], floats[1], floats[2]};
+            break;
+        case Ximu3DecoderTypeQuaternion:
+            message->data.quaternion = (Ximu3DataQuaternion){timestamp, floats[0], floats[1], floats[2], floats[3]};
+            break;
+        case Ximu3DecoderTypeRotationMatrix:
+            message->data.rotationMatrix = (Ximu3DataRotationMatrix){timestamp, floats[0], floats[1], floats[2], floats[3], floats[4], floats[5], floats[6], floats[7], floats[8]};
+            break;
+        case Ximu3DecoderTypeEulerAngles:
+            message->data.eulerAngles = (Ximu3DataEulerAngles){timestamp, floats[0], floats[1], floats[2]};
+            break;
+        case Ximu3DecoderTypeLinearAcceleration:
+            message->data.linearAcceleration = (Ximu3DataLinearAcceleration){timestamp, floats[0], floats[1], floats[2], floats[3], floats[4], floats[5], floats[6]};
+            break;
+        case Ximu3DecoderTypeEarthAcceleration:
+            message->data.earthAcceleration = (Ximu3DataEarthAcceleration){timestamp, floats[0], floats[1], floats[2], floats[3], floats[4], floats[5], floats[6]};
+            break;
+        case Ximu3DecoderTypeAhrsStatus:
+            message->data.ahrsStatus = (Ximu3DataAhrsStatus){timestamp, (Random() & 1) != 0, (Random() & 1) != 0, (Random() & 1) != 0, (Random() & 1) != 0};
+            break;
+        case Ximu3DecoderTypeHighGAccelerometer:
+            message->data.highGAccelerometer = (Ximu3DataHighGAccelerometer){timestamp, floats[0], floats[1], floats[2]};
+            break;
+        case Ximu3DecoderTypeTemperature:
+            message->data.temperature = (Ximu3DataTemperature){timestamp, floats[0]};
+            break;
+        case Ximu3DecoderTypeBattery:
+            message->data.battery = (Ximu3DataBattery){timestamp, floats[0], floats[1], floats[2]};
+            break;
+        case Ximu3DecoderTypeRssi:
+            message->data.rssi = (Ximu3DataRssi){timestamp, floats[0], floats[1]};
+            break;
+        case Ximu3DecoderTypeSerialAccessory:
+            message->data.serialAccessory = (Ximu3DataSerialAccessory){timestamp, (const uint8_t*) message->buffer, numberOfBytes};
+            break;
+        case Ximu3DecoderTypeNotification:
+            message->data.notification = (Ximu3DataNotification){timestamp, message->buffer};
+            break;
+        case Ximu3DecoderTypeError:
+            message->data.error = (Ximu3DataError){timestamp, message->buffer};
+            break;
+        case Ximu3DecoderTypeCommand:
+            message->data.command = "{}";
+            break;
+    }
+}
+
+/**
+ * @brief Encodes a message using Ximu3Data.c.
+ * @param message Message.
+ * @param binary True to encode as binary.
+ * @param destination Destination.
+ * @param destinationSize Destination size.
+ * @return Message size.
+ */
+static size_t Encode(const Ximu3DecoderMessage * const message, const bool binary, void* const destination, const size_t destinationSize) {
+    switch (message->type) {
+        case Ximu3DecoderTypeInertial:
+            return (binary ? Ximu3DataInertialBinary : Ximu3DataInertialAscii)(destination, destinationSize, &message->data.inertial);
+        case Ximu3DecoderTypeMagnetometer:
+            return (binary ? Ximu3DataMagnetometerBinary : Ximu3DataMagnetometerAscii)(destination, destinationSize, &message->data.magnetometer);
+        case Ximu3DecoderTypeQuaternion:
+            return (binary ? Ximu3DataQuaternionBinary : Ximu3DataQuaternionAscii)(destination, destinationSize, &message->data.quaternion);
+        case Ximu3DecoderTypeRotationMatrix:
+            return (binary ? Ximu3DataRotationMatrixBinary : Ximu3DataRotationMatrixAscii)(destination, destinationSize, &message->data.rotationMatrix);
+        case Ximu3DecoderTypeEulerAngles:
+            return (binary ? Ximu3DataEulerAnglesBinary : Ximu3DataEulerAnglesAscii)(destination, destinationSize, &message->data.eulerAngles);
+        case Ximu3DecoderTypeLinearAcceleration:
+            return (binary ? Ximu3DataLinearAccelerationBinary : Ximu3DataLinearAccelerationAscii)(destination, destinationSize, &message->data.linearAcceleration);
+        case Ximu3DecoderTypeEarthAcceleration:
+            return (binary ? Ximu3DataEarthAccelerationBinary : Ximu3DataEarthAccelerationAscii)(destination, destinationSize, &message->data.earthAcceleration);
+        case Ximu3DecoderTypeAhrsStatus:
+            return (binary ? Ximu3DataAhrsStatusBinary : Ximu3DataAhrsStatusAscii)(destination, destinationSize, &message->data.ahrsStatus);
+        case Ximu3DecoderTypeHighGAccelerometer:
+            return (binary ? Ximu3DataHighGAccelerometerBinary : Ximu3DataHighGAccelerometerAscii)(destination, destinationSize, &message->data.highGAccelerometer);
+        case Ximu3DecoderTypeTemperature:
+            return (binary ? Ximu3DataTemperatureBinary : Ximu3DataTemperatureAscii)(destination, destinationSize, &message->data.temperature);
+        case Ximu3DecoderTypeBattery:
+            return (binary ? Ximu3DataBatteryBinary : Ximu3DataBatteryAscii)(destination, destinationSize, &message->data.battery);
+        case Ximu3DecoderTypeRssi:
+            return (binary ? Ximu3DataRssiBinary : Ximu3DataRssiAscii)(destination, destinationSize, &message->data.rssi);
+        case Ximu3DecoderTypeSerialAccessory:
+            return (binary ? Ximu3DataSerialAccessoryBinary : Ximu3DataSerialAccessoryAscii)(destination, destinationSize, &message->data.serialAccessory);
+        case Ximu3DecoderTypeNotification:
+            return (binary ? Ximu3DataNotificationBinary : Ximu3DataNotificationAscii)(destination, destinationSize, &message->data.notification);
+        case Ximu3DecoderTypeError:
+            return (binary ? Ximu3DataErrorBinary : Ximu3DataErrorAscii)(destination, destinationSize, &message->data.error);
+        case Ximu3DecoderTypeCommand:
+            break;
+    }
+    return 0;
+}
+
+/**
+ * @brief Stream message callback. The message is encoded again and compared
+ * with the expected stream.
+ * @param message Message.
+ * @param context Context.
+ */
+static void StreamMessage(const Ximu3DecoderMessage * const message, void* const context) {
+    StreamContext * const streamContext = context;
+    uint8_t encoded[MESSAGE_SIZE];
+    const size_t size = Encode(message, message->binary, encoded, sizeof (encoded));
+    if (((streamContext->expectedIndex + size) > streamContext->expectedSize) || (memcmp(&streamContext->expected[streamContext->expectedIndex], encoded, size) != 0)) {
+        streamContext->match = false;
+    }
+    streamContext->expectedIndex += size;
+    streamContext->numberOfMessages++;
+}
+
+/**
+ * @brief Stream error callback.
+ * @param result Result.
+ * @param context Context.
+ */
+static void StreamError(const Ximu3DecoderResult result, void* const context) {
+    StreamContext * const streamContext = context;
+    streamContext->numberOfErrors++;
+}
+
+//------------------------------------------------------------------------------
+// End of file
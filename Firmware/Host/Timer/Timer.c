@@ -0,0 +1,133 @@
+/**
+ * @file Timer.c
+ * @author Seb Madgwick
+ * @brief Host stand-in for the PIC32 timer driver. The timer runs at the same
+ * rate as the device timer and is derived from the monotonic clock. The timer
+ * may instead be simulated so that time only advances when requested.
+ */
+
+//------------------------------------------------------------------------------
+// Includes
+
+#include "Timer.h"
+#include <time.h>
+
+//------------------------------------------------------------------------------
+// Function declarations
+
+static uint64_t MonotonicTicks(void);
+
+//------------------------------------------------------------------------------
+// Variables
+
+static uint64_t startTicks;
+static bool simulated;
+static uint64_t simulatedTicks;
+
+//------------------------------------------------------------------------------
+// Functions
+
+/**
+ * @brief Initialises the module. The timer is reset to zero.
+ */
+void TimerInitialise(void) {
+    TimerDeinitialise();
+}
+
+/**
+ * @brief Deinitialises the module. The timer is reset to zero.
+ */
+void TimerDeinitialise(void) {
+    startTicks = MonotonicTicks();
+    simulatedTicks = 0;
+}
+
+/**
+ * @brief Gets the 32-bit timer value.
+ * @return 32-bit timer value.
+ */
+uint32_t TimerGetTicks32(void) {
+    return (uint32_t) TimerGetTicks64();
+}
+
+/**
+ * @brief Gets the 64-bit timer value.
+ * @return 64-bit timer value.
+ */
+uint64_t TimerGetTicks64(void) {
+    if (simulated) {
+        return simulatedTicks;
+    }
+    return MonotonicTicks() - startTicks;
+}
+
+/**
+ * @brief Blocking delay in milliseconds. The delay advances the simulated
+ * timer if the timer is simulated.
+ * @param milliseconds Milliseconds.
+ */
+void TimerDelayMilliseconds(const uint32_t milliseconds) {
+    const uint64_t timeout = TimerGetTicks64() + ((uint64_t) milliseconds * (uint64_t) TIMER_TICKS_PER_MILLISECOND);
+    if (simulated) {
+        simulatedTicks = timeout;
+        return;
+    }
+    while (TimerGetTicks64() < timeout);
+}
+
+/**
+ * @brief Blocking delay in microseconds. The delay advances the simulated
+ * timer if the timer is simulated.
+ * @param microseconds Microseconds.
+ */
+void TimerDelayMicroseconds(const uint32_t microseconds) {
+    const uint64_t timeout = TimerGetTicks64() + ((uint64_t) microseconds * (uint64_t) TIMER_TICKS_PER_MICROSECOND);
+    if (simulated) {
+        simulatedTicks = timeout;
+        return;
+    }
+    while (TimerGetTicks64() < timeout);
+}
+
+/**
+ * @brief Selects the simulated timer. The simulated timer starts from the
+ * current timer value and only advances when TimerAdvance or a delay function
+ * is called.
+ * @param simulate True to simulate the timer, false to use the monotonic
+ * clock.
+ */
+void TimerSimulate(const bool simulate) {
+    if (simulate == simulated) {
+        return;
+    }
+    if (simulate) {
+        simulatedTicks = TimerGetTicks64();
+    } else {
+        startTicks = MonotonicTicks() - simulatedTicks;
+    }
+    simulated = simulate;
+}
+
+/**
+ * @brief Advances the simulated timer. Does nothing if the timer is not
+ * simulated.
+ * @param ticks Number of ticks.
+ */
+void TimerAdvance(const uint64_t ticks) {
+    if (simulated) {
+        simulatedTicks += ticks;
+    }
+}
+
+/**
+ * @brief Returns the monotonic clock in timer ticks.
+ * @return Monotonic clock in timer ticks.
+ */
+static uint64_t MonotonicTicks(void) {
+    struct timespec timespec;
+    clock_gettime(CLOCK_MONOTONIC, &timespec);
+    return ((uint64_t) timespec.tv_sec * TIMER_TICKS_PER_SECOND) + (((uint64_t) timespec.tv_nsec * TIMER_TICKS_PER_MICROSECOND) / 1000);
+}
+
+//------------------------------------------------------------------------------
+// End of file
@@ -0,0 +1,52 @@
+/**
+ * @file Timer.h
+ * @author Seb Madgwick
+ * @brief Host stand-in for the PIC32 timer driver. The timer runs at the same
+ * rate as the device timer and is derived from the monotonic clock. The timer
+ * may instead be simulated so that time only advances when requested.
+ */
+
+#ifndef TIMER_H
+#define TIMER_H
+
+//------------------------------------------------------------------------------
+// Includes
+
+#include <stdbool.h>
+#include <stdint.h>
+
+//------------------------------------------------------------------------------
+// Definitions
+
+/**
+ * @brief Timer ticks per second. Equal to the peripheral bus clock frequency
+ * of the device.
+ */
+#define TIMER_TICKS_PER_SECOND (24000000)
+
+/**
+ * @brief Timer ticks per millisecond.
+ */
+#define TIMER_TICKS_PER_MILLISECOND (TIMER_TICKS_PER_SECOND / 1000)
+
+/**
+ * @brief Timer ticks per microsecond.
+ */
+#define TIMER_TICKS_PER_MICROSECOND (TIMER_TICKS_PER_SECOND / 1000000)
+
+//------------------------------------------------------------------------------
+// Function declarations
+
+void TimerInitialise(void);
+void TimerDeinitialise(void);
+uint32_t TimerGetTicks32(void);
+uint64_t TimerGetTicks64(void);
+void TimerDelayMilliseconds(const uint32_t milliseconds);
+void TimerDelayMicroseconds(const uint32_t microseconds);
+void TimerSimulate(const bool simulate);
+void TimerAdvance(const uint64_t ticks);
+
+#endif
+
+//------------------------------------------------------------------------------
+// End of file
@@ -0,0 +1,492 @@
+/**
+ * @file Tmp117.c
+ * @author Seb Madgwick
+ * @brief Texas Instruments TMP117 model. The model is an I2C2 stand-in client
+ * and implements the register map, the conversion timing and averaging of
+ * table 7-7 of the TMP117 datasheet, and the ALERT pin. NACKs and stalls may
+ * be injected. The model uses the timer and so conversions are only
+ * deterministic if the timer is simulated.
+ */
+
+//------------------------------------------------------------------------------
+// Includes
+
+#include <math.h>
+#include "Timer/Timer.h"
+#include "Tmp117.h"
+
+//------------------------------------------------------------------------------
+// Definitions
+
+#define I2C_ADDRESS (0x48)
+
+/**
+ * @brief Register addresses.
+ */
+#define TEMP_RESULT (0x00)
+#define CONFIGURATION (0x01)
+#define T_HIGH_LIMIT (0x02)
+#define T_LOW_LIMIT (0x03)
+#define EEPROM_UL (0x04)
+#define EEPROM1 (0x05)
+#define EEPROM2 (0x06)
+#define TEMP_OFFSET (0x07)
+#define EEPROM3 (0x08)
+#define DEVICE_ID (0x0F)
+
+/**
+ * @brief Configuration register bits.
+ */
+#define HIGH_ALERT (1 << 15)
+#define LOW_ALERT (1 << 14)
+#define DATA_READY (1 << 13)
+#define MOD_POSITION (10)
+#define MOD_MASK (0b11 << MOD_POSITION)
+#define MOD_CONTINUOUS_CONVERSION (0b00 << MOD_POSITION)
+#define MOD_SHUTDOWN (0b01 << MOD_POSITION)
+#define MOD_CONTINUOUS_CONVERSION_ALTERNATE (0b10 << MOD_POSITION)
+#define MOD_ONE_SHOT (0b11 << MOD_POSITION)
+#define CONV_POSITION (7)
+#define CONV_MASK (0b111 << CONV_POSITION)
+#define AVG_POSITION (5)
+#define AVG_MASK (0b11 << AVG_POSITION)
+#define T_NA (1 << 4)
+#define POL (1 << 3)
+#define DR_ALERT (1 << 2)
+#define SOFT_RESET (1 << 1)
+#define CONFIGURATION_WRITABLE (0x0FFC)
+
+/**
+ * @brief Power-on register values.
+ */
+#define TEMP_RESULT_RESET (0x8000)
+#define CONFIGURATION_RESET (0x0220)
+#define T_HIGH_LIMIT_RESET (0x6000)
+#define T_LOW_LIMIT_RESET (0x8000)
+#define DEVICE_ID_VALUE (0x0117)
+
+/**
+ * @brief Time of a single conversion in microseconds.
+ */
+#define CONVERSION_TIME (15500)
+
+//------------------------------------------------------------------------------
+// Function declarations
+
+static I2CHostResponse Start(const bool read);
+static I2CHostResponse Write(const uint8_t byte);
+static I2CHostResponse Read(uint8_t * const byte);
+static void Stop(void);
+static void Reset(void);
+static void StartConversions(void);
+static void Update(void);
+static void ConversionComplete(void);
+static uint64_t Ticks(const uint32_t microseconds);
+static bool ValidRegister(const uint8_t address);
+static uint16_t ReadRegister(const uint8_t address);
+static uint16_t ReadConfiguration(void);
+static void WriteRegister(const uint8_t address, const uint16_t value);
+
+//------------------------------------------------------------------------------
+// Variables
+
+const I2CHostClient tmp117Client = {
+    .address = I2C_ADDRESS,
+    .start = Start,
+    .write = Write,
+    .read = Read,
+    .stop = Stop,
+};
+
+/**
+ * @brief Conversion cycle and averaging times in microseconds, and number of
+ * averages. See table 7-7 of the TMP117 datasheet.
+ */
+static const uint32_t conversionCycleTimes[] = {15500, 125000, 250000, 500000, 1000000, 4000000, 8000000, 16000000};
+static const uint32_t averagingTimes[] = {15500, 125000, 500000, 1000000};
+static const int numberOfAverages[] = {1, 8, 32, 64};
+
+static uint16_t configuration;
+static int16_t result;
+static int16_t highLimit;
+static int16_t lowLimit;
+static int16_t offset;
+static uint16_t eepromUnlock;
+static uint16_t eeprom[3];
+static bool highAlert;
+static bool lowAlert;
+static bool dataReady;
+static bool converting;
+static uint64_t cycleStart;
+static int sampleIndex;
+static float sampleTotal;
+static float temperature;
+static float clockError;
+static uint32_t nackCount;
+static uint32_t stallCount;
+static uint32_t numberOfConversions;
+static uint64_t resultTicks;
+static uint8_t pointer;
+static int byteIndex;
+static uint16_t writeValue;
+static uint16_t readValue;
+
+//------------------------------------------------------------------------------
+// Functions
+
+/**
+ * @brief Initialises the model. All registers are set to the power-on values
+ * and continuous conversion starts from the current time. The temperature is
+ * 25 degrees Celsius, the EEPROM is zero, the clock error is zero, and no
+ * NACKs or stalls are pending.
+ */
+void Tmp117Initialise(void) {
+    eeprom[0] = 0;
+    eeprom[1] = 0;
+    eeprom[2] = 0;
+    temperature = 25.0f;
+    clockError = 0.0f;
+    nackCount = 0;
+    stallCount = 0;
+    numberOfConversions = 0;
+    Reset();
+}
+
+/**
+ * @brief Sets the die temperature. Conversions in progress use the previous
+ * temperature up to the current time.
+ * @param temperature_ Temperature in degrees Celsius.
+ */
+void Tmp117SetTemperature(const float temperature_) {
+    Update();
+    temperature = temperature_;
+}
+
+/**
+ * @brief Sets the EEPROM registers.
+ * @param eeprom1 EEPROM1 register value.
+ * @param eeprom2 EEPROM2 register value.
+ * @param eeprom3 EEPROM3 register value.
+ */
+void Tmp117SetEeprom(const uint16_t eeprom1, const uint16_t eeprom2, const uint16_t eeprom3) {
+    eeprom[0] = eeprom1;
+    eeprom[1] = eeprom2;
+    eeprom[2] = eeprom3;
+}
+
+/**
+ * @brief Sets the error of the TMP117 oscillator. A positive error increases
+ * all conversion times.
+ * @param clockError_ Clock error in ppm.
+ */
+void Tmp117SetClockError(const float clockError_) {
+    Update();
+    clockError = clockError_;
+}
+
+/**
+ * @brief NACKs the next client addresses.
+ * @param numberOfAddresses Number of addresses.
+ */
+void Tmp117Nack(const uint32_t numberOfAddresses) {
+    nackCount = numberOfAddresses;
+}
+
+/**
+ * @brief Holds the clock low in response to the next client addresses.
+ * @param numberOfAddresses Number of addresses.
+ */
+void Tmp117Stall(const uint32_t numberOfAddresses) {
+    stallCount = numberOfAddresses;
+}
+
+/**
+ * @brief Returns the level of the ALERT pin. The pin indicates the data ready
+ * flag if the DR/Alert bit is set, and the alert flags otherwise. The POL bit
+ * selects the active level.
+ * @return True if the pin is high.
+ */
+bool Tmp117GetAlert(void) {
+    Update();
+    const bool active = (configuration & DR_ALERT) ? dataReady : (highAlert || lowAlert);
+    const bool activeHigh = (configuration & POL) != 0;
+    return active ? activeHigh : !activeHigh;
+}
+
+/**
+ * @brief Returns the number of conversion results since the model was
+ * initialised.
+ * @return Number of conversion results.
+ */
+uint32_t Tmp117GetNumberOfConversions(void) {
+    Update();
+    return numberOfConversions;
+}
+
+/**
+ * @brief Returns the time of the latest conversion result.
+ * @return Time of the latest conversion result in timer ticks.
+ */
+uint64_t Tmp117GetResultTicks(void) {
+    Update();
+    return resultTicks;
+}
+
+/**
+ * @brief Client address received. A read loads the register selected by the
+ * pointer.
+ * @param read True if the address is a read.
+ * @return Response.
+ */
+static I2CHostResponse Start(const bool read) {
+    if (stallCount > 0) {
+        stallCount--;
+        return I2CHostResponseStall;
+    }
+    if (nackCount > 0) {
+        nackCount--;
+        return I2CHostResponseNack;
+    }
+    byteIndex = 0;
+    if (read) {
+        readValue = ReadRegister(pointer);
+    }
+    return I2CHostResponseAck;
+}
+
+/**
+ * @brief Byte written. The first byte is the pointer and is NACKed if it is
+ * not a register address. The next two bytes are the register value, MSB
+ * first.
+ * @param byte Byte.
+ * @return Response.
+ */
+static I2CHostResponse Write(const uint8_t byte) {
+    switch (byteIndex++) {
+        case 0:
+            if (ValidRegister(byte) == false) {
+                return I2CHostResponseNack;
+            }
+            pointer = byte;
+            return I2CHostResponseAck;
+        case 1:
+            writeValue = (uint16_t) byte << 8;
+            return I2CHostResponseAck;
+        case 2:
+            writeValue |= byte;
+            WriteRegister(pointer, writeValue);
+            return I2CHostResponseAck;
+        default:
+            return I2CHostResponseNack;
+    }
+}
+
+/**
+ * @brief Byte read. The register value is read MSB first and repeats if more
+ * than two bytes are read.
+ * @param byte Byte.
+ * @return Response.
+ */
+static I2CHostResponse Read(uint8_t * const byte) {
+    *byte = (byteIndex++ % 2) == 0 ? (uint8_t) (readValue >> 8) : (uint8_t) readValue;
+    return I2CHostResponseAck;
+}
+
+/**
+ * @brief Stop event.
+ */
+static void Stop(void) {
+}
+
+/**
+ * @brief Sets all registers to the power-on values and starts conversions.
+ */
+static void Reset(void) {
+    configuration = CONFIGURATION_RESET;
+    result = (int16_t) TEMP_RESULT_RESET;
+    highLimit = (int16_t) T_HIGH_LIMIT_RESET;
+    lowLimit = (int16_t) T_LOW_LIMIT_RESET;
+    offset = 0;
+    eepromUnlock = 0;
+    highAlert = false;
+    lowAlert = false;
+    dataReady = false;
+    pointer = TEMP_RESULT;
+    StartConversions();
+}
+
+/**
+ * @brief Starts a conversion cycle from the current time for the mode of the
+ * configuration register.
+ */
+static void StartConversions(void) {
+    converting = (configuration & MOD_MASK) != MOD_SHUTDOWN;
+    cycleStart = TimerGetTicks64();
+    sampleIndex = 0;
+    sampleTotal = 0.0f;
+}
+
+/**
+ * @brief Completes all conversions up to the current time.
+ */
+static void Update(void) {
+    const uint64_t ticks = TimerGetTicks64();
+    while (converting) {
+        if ((cycleStart + Ticks(CONVERSION_TIME * (sampleIndex + 1))) > ticks) {
+            return;
+        }
+        sampleTotal += temperature;
+        sampleIndex++;
+        const int averaging = (configuration & AVG_MASK) >> AVG_POSITION;
+        if (sampleIndex < numberOfAverages[averaging]) {
+            continue;
+        }
+        resultTicks = cycleStart + Ticks(CONVERSION_TIME * sampleIndex);
+        ConversionComplete();
+        if ((configuration & MOD_MASK) == MOD_ONE_SHOT) {
+            configuration = (configuration & ~MOD_MASK) | MOD_SHUTDOWN;
+            converting = false;
+            return;
+        }
+        const uint32_t conversionCycleTime = conversionCycleTimes[(configuration & CONV_MASK) >> CONV_POSITION];
+        const uint32_t averagingTime = averagingTimes[averaging];
+        cycleStart += Ticks(averagingTime > conversionCycleTime ? averagingTime : conversionCycleTime);
+        sampleIndex = 0;
+        sampleTotal = 0.0f;
+    }
+}
+
+/**
+ * @brief Updates the temperature result register and flags with the average
+ * of the conversion.
+ */
+static void ConversionComplete(void) {
+    const float raw = roundf((sampleTotal / (float) sampleIndex) * 128.0f) + (float) offset;
+    result = (int16_t) fmaxf(fminf(raw, (float) INT16_MAX), (float) INT16_MIN);
+    dataReady = true;
+    numberOfConversions++;
+    if (configuration & T_NA) {
+        if (result > highLimit) {
+            highAlert = true;
+        } else if (result < lowLimit) {
+            highAlert = false;
+        }
+        return;
+    }
+    if (result > highLimit) {
+        highAlert = true;
+    }
+    if (result < lowLimit) {
+        lowAlert = true;
+    }
+}
+
+/**
+ * @brief Converts a TMP117 time to timer ticks.
+ * @param microseconds TMP117 time in microseconds.
+ * @return Timer ticks.
+ */
+static uint64_t Ticks(const uint32_t microseconds) {
+    return (uint64_t) ((double) microseconds * TIMER_TICKS_PER_MICROSECOND * (1.0 + (clockError * 1E-6)));
+}
+
+/**
+ * @brief Returns true if the address is a register address.
+ * @param address Address.
+ * @return True if the address is a register address.
+ */
+static bool ValidRegister(const uint8_t address) {
+    return (address <= EEPROM3) || (address == DEVICE_ID);
+}
+
+/**
+ * @brief Reads a register. Reading the temperature result register clears the
+ * data ready flag.
+ * @param address Register address.
+ * @return Register value.
+ */
+static uint16_t ReadRegister(const uint8_t address) {
+    Update();
+    switch (address) {
+        case TEMP_RESULT:
+            dataReady = false;
+            return (uint16_t) result;
+        case CONFIGURATION:
+            return ReadConfiguration();
+        case T_HIGH_LIMIT:
+            return (uint16_t) highLimit;
+        case T_LOW_LIMIT:
+            return (uint16_t) lowLimit;
+        case EEPROM_UL:
+            return eepromUnlock;
+        case EEPROM1:
+            return eeprom[0];
+        case EEPROM2:
+            return eeprom[1];
+        case TEMP_OFFSET:
+            return (uint16_t) offset;
+        case EEPROM3:
+            return eeprom[2];
+        case DEVICE_ID:
+            return DEVICE_ID_VALUE;
+        default:
+            return 0;
+    }
+}
+
+/**
+ * @brief Reads the configuration register. Reading the configuration register
+ * clears the data ready flag and, in alert mode, the alert flags.
+ * @return Configuration register value.
+ */
+static uint16_t ReadConfiguration(void) {
+    uint16_t value = configuration;
+    if ((value & MOD_MASK) == MOD_CONTINUOUS_CONVERSION_ALTERNATE) {
+        value &= ~MOD_MASK;
+    }
+    value |= (highAlert ? HIGH_ALERT : 0) | (lowAlert ? LOW_ALERT : 0) | (dataReady ? DATA_READY : 0);
+    dataReady = false;
+    if ((configuration & T_NA) == 0) {
+        highAlert = false;
+        lowAlert = false;
+    }
+    return value;
+}
+
+/**
+ * @brief Writes a register. A configuration register write restarts the
+ * conversion cycle. EEPROM programming is not modelled and so writes to the
+ * EEPROM registers are ignored.
+ * @param address Register address.
+ * @param value Register value.
+ */
+static void WriteRegister(const uint8_t address, const uint16_t value) {
+    Update();
+    switch (address) {
+        case CONFIGURATION:
+            if (value & SOFT_RESET) {
+                Reset();
+                break;
+            }
+            configuration = value & CONFIGURATION_WRITABLE;
+            StartConversions();
+            break;
+        case T_HIGH_LIMIT:
+            highLimit = (int16_t) value;
+            break;
+        case T_LOW_LIMIT:
+            lowLimit = (int16_t) value;
+            break;
+        case EEPROM_UL:
+            eepromUnlock = value;
+            break;
+        case TEMP_OFFSET:
+            offset = (int16_t) value;
+            break;
+        default:
+            break;
+    }
+}
+
+//------------------------------------------------------------------------------
+// End of file
@@ -0,0 +1,42 @@
+/**
+ * @file Tmp117.h
+ * @author Seb Madgwick
+ * @brief Texas Instruments TMP117 model. The model is an I2C2 stand-in client
+ * and implements the register map, the conversion timing and averaging of
+ * table 7-7 of the TMP117 datasheet, and the ALERT pin. NACKs and stalls may
+ * be injected. The model uses the timer and so conversions are only
+ * deterministic if the timer is simulated.
+ */
+
+#ifndef TMP117_H
+#define TMP117_H
+
+//------------------------------------------------------------------------------
+// Includes
+
+#include "I2C/I2C2Host.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+//------------------------------------------------------------------------------
+// Variable declarations
+
+extern const I2CHostClient tmp117Client;
+
+//------------------------------------------------------------------------------
+// Function declarations
+
+void Tmp117Initialise(void);
+void Tmp117SetTemperature(const float temperature);
+void Tmp117SetEeprom(const uint16_t eeprom1, const uint16_t eeprom2, const uint16_t eeprom3);
+void Tmp117SetClockError(const float clockError);
+void Tmp117Nack(const uint32_t numberOfAddresses);
+void Tmp117Stall(const uint32_t numberOfAddresses);
+bool Tmp117GetAlert(void);
+uint32_t Tmp117GetNumberOfConversions(void);
+uint64_t Tmp117GetResultTicks(void);
+
+#endif
+
+//------------------------------------------------------------------------------
+// End of file
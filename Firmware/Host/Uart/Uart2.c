@@ -0,0 +1,30 @@
+/**
+ * @file Uart2.c
+ * @author Seb Madgwick
+ * @brief Host stand-in for the UART2 driver. The debug UART is stdout and so
+ * only initialisation is provided.
+ */
+
+//------------------------------------------------------------------------------
+// Includes
+
+#include "Uart/Uart2.h"
+
+//------------------------------------------------------------------------------
+// Functions
+
+/**
+ * @brief Initialises the module.
+ * @param settings Settings.
+ */
+void Uart2Initialise(const UartSettings * const settings) {
+}
+
+/**
+ * @brief Disables the module.
+ */
+void Uart2Deinitialise(void) {
+}
+
+//------------------------------------------------------------------------------
+// End of file
@@ -0,0 +1,293 @@
+/**
+ * @file UsbCdc.c
+ * @author Seb Madgwick
+ * @brief Host stand-in for the USB CDC wrapper. The read and write buffers
+ * are the same as those of the device and are accessed by the host side using
+ * the functions in UsbCdcHost.h. The buffers may instead be connected to a
+ * pseudo-terminal so that the device can be used by host applications as a
+ * serial port.
+ */
+
+//------------------------------------------------------------------------------
+// Includes
+
+#define _GNU_SOURCE // for posix_openpt, grantpt, unlockpt and ptsname
+#include "Config.h"
+#include <fcntl.h>
+#include "MaskedFifo.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <termios.h>
+#include <unistd.h>
+#include "Usb/UsbCdc.h"
+#include "UsbCdcHost.h"
+
+//------------------------------------------------------------------------------
+// Variables
+
+static bool hostConnected = true;
+static uint32_t readBufferOverflow;
+static uint8_t readData[USB_CDC_READ_BUFFER_SIZE];
+MASKED_FIFO_ASSERT_SIZE(readData);
+static MaskedFifo readFifo = {.data = readData, .mask = sizeof (readData) - 1};
+static uint8_t writeData[USB_CDC_WRITE_BUFFER_SIZE];
+MASKED_FIFO_ASSERT_SIZE(writeData);
+static MaskedFifo writeFifo = {.data = writeData, .mask = sizeof (writeData) - 1};
+static int ptyMaster = -1;
+static int ptySlave = -1;
+static char ptyName[64];
+
+//------------------------------------------------------------------------------
+// Functions
+
+/**
+ * @brief Module tasks. This function should be called repeatedly within the
+ * main program loop. Transfers data between the buffers and the
+ * pseudo-terminal if open. Data is only received while there is space in the
+ * read buffer, the same as the flow control of USB.
+ */
+void UsbCdcTasks(void) {
+    if (ptyMaster < 0) {
+        return;
+    }
+
+    // Receive
+    volatile void* pointer;
+    size_t numberOfBytes;
+    MaskedFifoWritePointer(&readFifo, &pointer, &numberOfBytes);
+    if (numberOfBytes > 0) {
+        const ssize_t numberOfBytesRead = read(ptyMaster, (void*) pointer, numberOfBytes);
+        if (numberOfBytesRead > 0) {
+            MaskedFifoWritePointerComplete(&readFifo, (size_t) numberOfBytesRead);
+        }
+    }
+
+    // Transmit
+    MaskedFifoReadPointer(&writeFifo, &pointer, &numberOfBytes);
+    if (numberOfBytes > 0) {
+        const ssize_t numberOfBytesWritten = write(ptyMaster, (const void*) pointer, numberOfBytes);
+        if (numberOfBytesWritten > 0) {
+            MaskedFifoReadPointerComplete(&writeFifo, (size_t) numberOfBytesWritten);
+        }
+    }
+}
+
+/**
+ * @brief Returns true if VBUS is valid.
+ * @return True if VBUS is valid.
+ */
+bool UsbCdcVbusValid(void) {
+    return hostConnected;
+}
+
+/**
+ * @brief Returns true if the USB host is connected.
+ * @return True if the USB host is connected.
+ */
+bool UsbCdcHostConnected(void) {
+    return hostConnected;
+}
+
+/**
+ * @brief Returns true if the port is open.
+ * @return True if the port is open.
+ */
+bool UsbCdcPortOpen(void) {
+    return hostConnected;
+}
+
+/**
+ * @brief Returns the number of bytes available in the read buffer.
+ * @return Number of bytes available in the read buffer.
+ */
+size_t UsbCdcAvailableRead(void) {
+    return MaskedFifoAvailableRead(&readFifo);
+}
+
+/**
+ * @brief Reads data from the read buffer.
+ * @param destination Destination.
+ * @param numberOfBytes Number of bytes.
+ * @return Number of bytes read.
+ */
+size_t UsbCdcRead(void* const destination, size_t numberOfBytes) {
+    return MaskedFifoRead(&readFifo, destination, numberOfBytes);
+}
+
+/**
+ * @brief Reads a byte from the read buffer. This function must only be called
+ * if there are bytes available in the read buffer.
+ * @return Byte.
+ */
+uint8_t UsbCdcReadByte(void) {
+    return MaskedFifoReadByte(&readFifo);
+}
+
+/**
+ * @brief Provides a pointer to the next contiguous block of data in the read
+ * buffer so that data can be read without an intermediate copy. The data may
+ * be modified in place. UsbCdcReadPointerComplete must be called after data
+ * has been read.
+ * @param pointer Pointer.
+ * @param numberOfBytes Number of bytes.
+ */
+void UsbCdcReadPointer(void* * const pointer, size_t * const numberOfBytes) {
+    MaskedFifoReadPointer(&readFifo, (volatile void**) pointer, numberOfBytes);
+}
+
+/**
+ * @brief Updates the read buffer after UsbCdcReadPointer.
+ * @param numberOfBytes Number of bytes.
+ */
+void UsbCdcReadPointerComplete(const size_t numberOfBytes) {
+    MaskedFifoReadPointerComplete(&readFifo, numberOfBytes);
+}
+
+/**
+ * @brief Returns the total number of received bytes discarded because the read
+ * buffer was full.
+ * @return Total number of received bytes discarded.
+ */
+uint32_t UsbCdcReadBufferOverflow(void) {
+    return readBufferOverflow;
+}
+
+/**
+ * @brief Returns the space available in the write buffer.
+ * @return Space available in the write buffer.
+ */
+size_t UsbCdcAvailableWrite(void) {
+    return MaskedFifoAvailableWrite(&writeFifo);
+}
+
+/**
+ * @brief Writes data to the write buffer.
+ * @param data Data.
+ * @param numberOfBytes Number of bytes.
+ * @return Result.
+ */
+FifoResult UsbCdcWrite(const void* const data, const size_t numberOfBytes) {
+    return MaskedFifoWrite(&writeFifo, data, numberOfBytes);
+}
+
+/**
+ * @brief Provides a pointer to the next contiguous block of space in the write
+ * buffer so that data can be written without an intermediate copy.
+ * UsbCdcWritePointerComplete must be called after data has been written.
+ * @param pointer Pointer.
+ * @param numberOfBytes Number of bytes.
+ */
+void UsbCdcWritePointer(void* * const pointer, size_t * const numberOfBytes) {
+    MaskedFifoWritePointer(&writeFifo, (volatile void**) pointer, numberOfBytes);
+}
+
+/**
+ * @brief Updates the write buffer after UsbCdcWritePointer.
+ * @param numberOfBytes Number of bytes.
+ */
+void UsbCdcWritePointerComplete(const size_t numberOfBytes) {
+    MaskedFifoWritePointerComplete(&writeFifo, numberOfBytes);
+}
+
+/**
+ * @brief Writes a byte to the write buffer.
+ * @param byte Byte.
+ * @return Result.
+ */
+FifoResult UsbCdcWriteByte(const uint8_t byte) {
+    return MaskedFifoWriteByte(&writeFifo, byte);
+}
+
+/**
+ * @brief Connects or disconnects the USB host. The host is connected by
+ * default. Data written while the host is disconnected is discarded.
+ * @param connected True to connect the host.
+ */
+void UsbCdcHostConnect(const bool connected) {
+    hostConnected = connected;
+}
+
+/**
+ * @brief Sends data from the USB host to the read buffer. Bytes that do not
+ * fit in the read buffer are discarded and counted as an overflow.
+ * @param data Data.
+ * @param numberOfBytes Number of bytes.
+ * @return Number of bytes added to the read buffer.
+ */
+size_t UsbCdcHostSend(const void* const data, const size_t numberOfBytes) {
+    const size_t space = MaskedFifoAvailableWrite(&readFifo);
+    const size_t numberOfBytesAdded = numberOfBytes < space ? numberOfBytes : space;
+    MaskedFifoWrite(&readFifo, data, numberOfBytesAdded);
+    readBufferOverflow += numberOfBytes - numberOfBytesAdded;
+    return numberOfBytesAdded;
+}
+
+/**
+ * @brief Receives data from the write buffer as the USB host. The write
+ * buffer is discarded if the host is disconnected.
+ * @param destination Destination.
+ * @param numberOfBytes Number of bytes.
+ * @return Number of bytes received.
+ */
+size_t UsbCdcHostReceive(void* const destination, const size_t numberOfBytes) {
+    if (hostConnected == false) {
+        MaskedFifoClear(&writeFifo);
+        return 0;
+    }
+    return MaskedFifoRead(&writeFifo, destination, numberOfBytes);
+}
+
+/**
+ * @brief Opens a pseudo-terminal and connects it to the buffers. Host
+ * applications open the returned device name as a serial port. The
+ * pseudo-terminal is raw so that binary data is not modified.
+ * @return Device name of the pseudo-terminal, or NULL if the pseudo-terminal
+ * could not be opened.
+ */
+const char* UsbCdcHostOpenPty(void) {
+    UsbCdcHostClosePty();
+    ptyMaster = posix_openpt(O_RDWR | O_NOCTTY);
+    if (ptyMaster < 0) {
+        return NULL;
+    }
+    const char* const name = ((grantpt(ptyMaster) == 0) && (unlockpt(ptyMaster) == 0)) ? ptsname(ptyMaster) : NULL;
+    if (name != NULL) {
+        snprintf(ptyName, sizeof (ptyName), "%s", name);
+        ptySlave = open(ptyName, O_RDWR | O_NOCTTY); // held open so that the port may be closed and reopened by host applications
+    }
+    struct termios termios;
+    if ((ptySlave < 0) || (tcgetattr(ptySlave, &termios) != 0)) {
+        UsbCdcHostClosePty();
+        return NULL;
+    }
+    cfmakeraw(&termios);
+    tcsetattr(ptySlave, TCSANOW, &termios);
+    fcntl(ptyMaster, F_SETFL, fcntl(ptyMaster, F_GETFL) | O_NONBLOCK);
+    return ptyName;
+}
+
+/**
+ * @brief Closes the pseudo-terminal.
+ */
+void UsbCdcHostClosePty(void) {
+    if (ptySlave >= 0) {
+        close(ptySlave);
+        ptySlave = -1;
+    }
+    if (ptyMaster >= 0) {
+        close(ptyMaster);
+        ptyMaster = -1;
+    }
+}
+
+/**
+ * @brief Clears the read and write buffers and the overflow count.
+ */
+void UsbCdcHostClear(void) {
+    MaskedFifoClear(&readFifo);
+    MaskedFifoClear(&writeFifo);
+    readBufferOverflow = 0;
+}
+
+//------------------------------------------------------------------------------
+// End of file
@@ -0,0 +1,31 @@
+/**
+ * @file UsbCdcHost.h
+ * @author Seb Madgwick
+ * @brief Host side of the USB CDC stand-in. These functions act as the USB
+ * host and transfer data to and from the buffers used by the UsbCdc API, or
+ * connect the buffers to a pseudo-terminal.
+ */
+
+#ifndef USB_CDC_HOST_H
+#define USB_CDC_HOST_H
+
+//------------------------------------------------------------------------------
+// Includes
+
+#include <stdbool.h>
+#include <stddef.h>
+
+//------------------------------------------------------------------------------
+// Function declarations
+
+void UsbCdcHostConnect(const bool connected);
+size_t UsbCdcHostSend(const void* const data, const size_t numberOfBytes);
+size_t UsbCdcHostReceive(void* const destination, const size_t numberOfBytes);
+void UsbCdcHostClear(void);
+const char* UsbCdcHostOpenPty(void);
+void UsbCdcHostClosePty(void);
+
+#endif
+
+//------------------------------------------------------------------------------
+// End of file
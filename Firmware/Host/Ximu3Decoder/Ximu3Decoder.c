@@ -0,0 +1,416 @@
+/**
+ * @file Ximu3Decoder.c
+ * @author Seb Madgwick
+ * @brief Decoder for the binary and ASCII data messages written by
+ * Ximu3Data.c. Binary messages are un-stuffed and all messages are dispatched
+ * on the first byte. Command responses are passed through as JSON strings.
+ */
+
+//------------------------------------------------------------------------------
+// Includes
+
+#include "x-IMU3-Device/Binary.h"
+#include <stdlib.h>
+#include <string.h>
+#include "Ximu3Decoder.h"
+
+//------------------------------------------------------------------------------
+// Definitions
+
+/**
+ * @brief Maximum number of floats of a data message.
+ */
+#define MAXIMUM_NUMBER_OF_FLOATS (9)
+
+/**
+ * @brief Number of floats for messages with a variable number of bytes.
+ */
+#define VARIABLE (-1)
+
+/**
+ * @brief Message format.
+ */
+typedef struct {
+    char character;
+    Ximu3DecoderType type;
+    int numberOfFloats;
+} Format;
+
+//------------------------------------------------------------------------------
+// Function declarations
+
+static const Format* FindFormat(const char character);
+static Ximu3DecoderResult ParseBinary(const uint8_t * const message, const size_t messageSize, Ximu3DecoderMessage * const decoded);
+static Ximu3DecoderResult ParseAscii(const uint8_t * const message, const size_t messageSize, Ximu3DecoderMessage * const decoded);
+static void SetFloats(Ximu3DecoderMessage * const decoded, const uint64_t timestamp, const float* const floats);
+static void SetBytes(Ximu3DecoderMessage * const decoded, const uint64_t timestamp, const char* const bytes, const size_t numberOfBytes);
+static void Complete(Ximu3Decoder * const decoder, const uint8_t * const message, const size_t messageSize);
+
+//------------------------------------------------------------------------------
+// Variables
+
+static const Format formats[] = {
+    {'I', Ximu3DecoderTypeInertial, 6},
+    {'M', Ximu3DecoderTypeMagnetometer, 3},
+    {'Q', Ximu3DecoderTypeQuaternion, 4},
+    {'R', Ximu3DecoderTypeRotationMatrix, 9},
+    {'A', Ximu3DecoderTypeEulerAngles, 3},
+    {'L', Ximu3DecoderTypeLinearAcceleration, 7},
+    {'E', Ximu3DecoderTypeEarthAcceleration, 7},
+    {'U', Ximu3DecoderTypeAhrsStatus, 4},
+    {'H', Ximu3DecoderTypeHighGAccelerometer, 3},
+    {'T', Ximu3DecoderTypeTemperature, 1},
+    {'B', Ximu3DecoderTypeBattery, 3},
+    {'W', Ximu3DecoderTypeRssi, 2},
+    {'S', Ximu3DecoderTypeSerialAccessory, VARIABLE},
+    {'N', Ximu3DecoderTypeNotification, VARIABLE},
+    {'F', Ximu3DecoderTypeError, VARIABLE},
+};
+
+//------------------------------------------------------------------------------
+// Functions
+
+/**
+ * @brief Processes received data. The message callback is called for each
+ * complete message and the error callback is called for each message that
+ * cannot be decoded. Complete messages are decoded directly from the data if
+ * no data is buffered.
+ * @param decoder Decoder.
+ * @param data Data.
+ * @param numberOfBytes Number of bytes.
+ */
+void Ximu3DecoderProcess(Ximu3Decoder * const decoder, const void* const data, const size_t numberOfBytes) {
+    const uint8_t * const bytes = data;
+    size_t index = 0;
+    while (index < numberOfBytes) {
+        const uint8_t * const run = &bytes[index];
+        const uint8_t * const termination = memchr(run, BYTE_STUFFING_END, numberOfBytes - index);
+        const size_t runSize = termination == NULL ? (numberOfBytes - index) : (size_t) (termination - run) + 1;
+        index += runSize;
+
+        // Decode in place if the run is a complete message
+        if ((termination != NULL) && (decoder->index == 0) && (decoder->discard == false)) {
+            Complete(decoder, run, runSize);
+            continue;
+        }
+
+        // Add to buffer or discard if too long
+        if ((decoder->discard == false) && ((decoder->index + runSize) <= sizeof (decoder->buffer))) {
+            memcpy(&decoder->buffer[decoder->index], run, runSize);
+            decoder->index += runSize;
+        } else {
+            decoder->discard = true;
+            decoder->index = 0;
+        }
+
+        // Decode buffered message
+        if (termination == NULL) {
+            continue;
+        }
+        if (decoder->discard) {
+            decoder->discard = false;
+            if (decoder->error != NULL) {
+                decoder->error(Ximu3DecoderResultTooLong, decoder->context);
+            }
+            continue;
+        }
+        Complete(decoder, decoder->buffer, decoder->index);
+        decoder->index = 0;
+    }
+}
+
+/**
+ * @brief Decodes a complete message and calls the message or error callback.
+ * @param decoder Decoder.
+ * @param message Message.
+ * @param messageSize Message size.
+ */
+static void Complete(Ximu3Decoder * const decoder, const uint8_t * const message, const size_t messageSize) {
+    const Ximu3DecoderResult result = Ximu3DecoderParse(message, messageSize, &decoder->decoded);
+    if (result == Ximu3DecoderResultOk) {
+        decoder->message(&decoder->decoded, decoder->context);
+    } else if (decoder->error != NULL) {
+        decoder->error(result, decoder->context);
+    }
+}
+
+/**
+ * @brief Decodes a message. The termination is optional.
+ * @param message Message.
+ * @param messageSize Message size.
+ * @param decoded Decoded message.
+ * @return Result.
+ */
+Ximu3DecoderResult Ximu3DecoderParse(const void* const message, const size_t messageSize, Ximu3DecoderMessage * const decoded) {
+    const uint8_t * const bytes = message;
+
+    // Remove termination
+    size_t size = messageSize;
+    if ((size > 0) && (bytes[size - 1] == BYTE_STUFFING_END)) {
+        size--;
+    }
+    if (size == 0) {
+        return Ximu3DecoderResultInvalidSize;
+    }
+    if (size >= sizeof (decoded->buffer)) {
+        return Ximu3DecoderResultTooLong;
+    }
+
+    // Command response
+    if (bytes[0] == '{') {
+        memcpy(decoded->buffer, bytes, size);
+        decoded->buffer[size] = '\0';
+        decoded->type = Ximu3DecoderTypeCommand;
+        decoded->binary = false;
+        decoded->data.command = decoded->buffer;
+        return Ximu3DecoderResultOk;
+    }
+
+    // Data message
+    if (bytes[0] >= 0x80) {
+        return ParseBinary(bytes, size, decoded);
+    }
+    return ParseAscii(bytes, size, decoded);
+}
+
+/**
+ * @brief Returns the format for a first character.
+ * @param character First character.
+ * @return Format or NULL if the character is unknown.
+ */
+static const Format* FindFormat(const char character) {
+    for (size_t index = 0; index < (sizeof (formats) / sizeof (formats[0])); index++) {
+        if (formats[index].character == character) {
+            return &formats[index];
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief Decodes a binary message.
+ * @param message Message without the termination.
+ * @param messageSize Message size.
+ * @param decoded Decoded message.
+ * @return Result.
+ */
+static Ximu3DecoderResult ParseBinary(const uint8_t * const message, const size_t messageSize, Ximu3DecoderMessage * const decoded) {
+
+    // Un-stuff
+    uint8_t * const buffer = (uint8_t*) decoded->buffer;
+    size_t size = 0;
+    for (size_t index = 0; index < messageSize; index++) {
+        uint8_t byte = message[index];
+        if (byte == BYTE_STUFFING_ESC) {
+            if (++index >= messageSize) {
+                return Ximu3DecoderResultInvalidEscape;
+            }
+            switch (message[index]) {
+                case BYTE_STUFFING_ESC_END:
+                    byte = BYTE_STUFFING_END;
+                    break;
+                case BYTE_STUFFING_ESC_ESC:
+                    byte = BYTE_STUFFING_ESC;
+                    break;
+                default:
+                    return Ximu3DecoderResultInvalidEscape;
+            }
+        }
+        buffer[size++] = byte;
+    }
+
+    // Find format
+    const Format * const format = FindFormat((char) (buffer[0] - 0x80));
+    if (format == NULL) {
+        return Ximu3DecoderResultUnknownType;
+    }
+    const size_t headerSize = 1 + sizeof (uint64_t);
+    if ((size < headerSize) || ((format->numberOfFloats != VARIABLE) && (size != (headerSize + (format->numberOfFloats * sizeof (float)))))) {
+        return Ximu3DecoderResultInvalidSize;
+    }
+    decoded->type = format->type;
+    decoded->binary = true;
+
+    // Timestamp
+    uint64_t timestamp = 0;
+    for (int index = 7; index >= 0; index--) {
+        timestamp = (timestamp << 8) | buffer[1 + index];
+    }
+
+    // Bytes
+    if (format->numberOfFloats == VARIABLE) {
+        buffer[size] = '\0';
+        SetBytes(decoded, timestamp, &decoded->buffer[headerSize], size - headerSize);
+        return Ximu3DecoderResultOk;
+    }
+
+    // Floats
+    float floats[MAXIMUM_NUMBER_OF_FLOATS];
+    for (int index = 0; index < format->numberOfFloats; index++) {
+        const uint8_t * const word = &buffer[headerSize + (index * sizeof (float))];
+        const uint32_t value = (uint32_t) word[0] | ((uint32_t) word[1] << 8) | ((uint32_t) word[2] << 16) | ((uint32_t) word[3] << 24);
+        memcpy(&floats[index], &value, sizeof (float));
+    }
+    SetFloats(decoded, timestamp, floats);
+    return Ximu3DecoderResultOk;
+}
+
+/**
+ * @brief Decodes an ASCII message.
+ * @param message Message without the termination.
+ * @param messageSize Message size.
+ * @param decoded Decoded message.
+ * @return Result.
+ */
+static Ximu3DecoderResult ParseAscii(const uint8_t * const message, const size_t messageSize, Ximu3DecoderMessage * const decoded) {
+
+    // Find format
+    const Format * const format = FindFormat((char) message[0]);
+    if (format == NULL) {
+        return Ximu3DecoderResultUnknownType;
+    }
+    decoded->type = format->type;
+    decoded->binary = false;
+
+    // Copy as string
+    char* const buffer = decoded->buffer;
+    memcpy(buffer, message, messageSize);
+    buffer[messageSize] = '\0';
+
+    // Timestamp
+    if ((buffer[1] != ',') || (buffer[2] < '0') || (buffer[2] > '9')) {
+        return Ximu3DecoderResultInvalidNumber;
+    }
+    char* end;
+    const uint64_t timestamp = strtoull(&buffer[2], &end, 10);
+
+    // Bytes
+    if (format->numberOfFloats == VARIABLE) {
+        if (*end != ',') {
+            return Ximu3DecoderResultInvalidSize;
+        }
+        end++;
+        SetBytes(decoded, timestamp, end, (size_t) (&buffer[messageSize] - end));
+        return Ximu3DecoderResultOk;
+    }
+
+    // Floats
+    float floats[MAXIMUM_NUMBER_OF_FLOATS];
+    for (int index = 0; index < format->numberOfFloats; index++) {
+        if (*end != ',') {
+            return Ximu3DecoderResultInvalidSize;
+        }
+        const char* const start = end + 1;
+        floats[index] = strtof(start, &end);
+        if (end == start) {
+            return Ximu3DecoderResultInvalidNumber;
+        }
+    }
+    if (*end != '\0') {
+        return *end == ',' ? Ximu3DecoderResultInvalidSize : Ximu3DecoderResultInvalidNumber;
+    }
+    SetFloats(decoded, timestamp, floats);
+    return Ximu3DecoderResultOk;
+}
+
+/**
+ * @brief Sets the message data for a message with floats.
+ * @param decoded Decoded message. The type must be set.
+ * @param timestamp Timestamp.
+ * @param floats Floats.
+ */
+static void SetFloats(Ximu3DecoderMessage * const decoded, const uint64_t timestamp, const float* const floats) {
+    switch (decoded->type) {
+        case Ximu3DecoderTypeInertial:
+            decoded->data.inertial = (Ximu3DataInertial){timestamp, floats[0], floats[1], floats[2], floats[3], floats[4], floats[5]};
+            break;
+        case Ximu3DecoderTypeMagnetometer:
+            decoded->data.magnetometer = (Ximu3DataMagnetometer){timestamp, floats[0], floats[1], floats[2]};
+            break;
+        case Ximu3DecoderTypeQuaternion:
+            decoded->data.quaternion = (Ximu3DataQuaternion){timestamp, floats[0], floats[1], floats[2], floats[3]};
+            break;
+        case Ximu3DecoderTypeRotationMatrix:
+            decoded->data.rotationMatrix = (Ximu3DataRotationMatrix){timestamp, floats[0], floats[1], floats[2], floats[3], floats[4], floats[5], floats[6], floats[7], floats[8]};
+            break;
+        case Ximu3DecoderTypeEulerAngles:
+            decoded->data.eulerAngles = (Ximu3DataEulerAngles){timestamp, floats[0], floats[1], floats[2]};
+            break;
+        case Ximu3DecoderTypeLinearAcceleration:
+            decoded->data.linearAcceleration = (Ximu3DataLinearAcceleration){timestamp, floats[0], floats[1], floats[2], floats[3], floats[4], floats[5], floats[6]};
+            break;
+        case Ximu3DecoderTypeEarthAcceleration:
+            decoded->data.earthAcceleration = (Ximu3DataEarthAcceleration){timestamp, floats[0], floats[1], floats[2], floats[3], floats[4], floats[5], floats[6]};
+            break;
+        case Ximu3DecoderTypeAhrsStatus:
+            decoded->data.ahrsStatus = (Ximu3DataAhrsStatus){timestamp, floats[0] != 0.0f, floats[1] != 0.0f, floats[2] != 0.0f, floats[3] != 0.0f};
+            break;
+        case Ximu3DecoderTypeHighGAccelerometer:
+            decoded->data.highGAccelerometer = (Ximu3DataHighGAccelerometer){timestamp, floats[0], floats[1], floats[2]};
+            break;
+        case Ximu3DecoderTypeTemperature:
+            decoded->data.temperature = (Ximu3DataTemperature){timestamp, floats[0]};
+            break;
+        case Ximu3DecoderTypeBattery:
+            decoded->data.battery = (Ximu3DataBattery){timestamp, floats[0], floats[1], floats[2]};
+            break;
+        case Ximu3DecoderTypeRssi:
+            decoded->data.rssi = (Ximu3DataRssi){timestamp, floats[0], floats[1]};
+            break;
+        case Ximu3DecoderTypeSerialAccessory:
+        case Ximu3DecoderTypeNotification:
+        case Ximu3DecoderTypeError:
+        case Ximu3DecoderTypeCommand:
+            break; // avoid compiler warning
+    }
+}
+
+/**
+ * @brief Sets the message data for a message with bytes. The bytes must be
+ * null terminated.
+ * @param decoded Decoded message. The type must be set.
+ * @param timestamp Timestamp.
+ * @param bytes Bytes.
+ * @param numberOfBytes Number of bytes.
+ */
+static void SetBytes(Ximu3DecoderMessage * const decoded, const uint64_t timestamp, const char* const bytes, const size_t numberOfBytes) {
+    switch (decoded->type) {
+        case Ximu3DecoderTypeSerialAccessory:
+            decoded->data.serialAccessory = (Ximu3DataSerialAccessory){timestamp, (const uint8_t*) bytes, numberOfBytes};
+            break;
+        case Ximu3DecoderTypeNotification:
+            decoded->data.notification = (Ximu3DataNotification){timestamp, bytes};
+            break;
+        case Ximu3DecoderTypeError:
+            decoded->data.error = (Ximu3DataError){timestamp, bytes};
+            break;
+        default:
+            break;
+    }
+}
+
+/**
+ * @brief Returns the result message.
+ * @param result Result.
+ * @return Result message.
+ */
+const char* Ximu3DecoderResultToString(const Ximu3DecoderResult result) {
+    switch (result) {
+        case Ximu3DecoderResultOk:
+            return "OK";
+        case Ximu3DecoderResultUnknownType:
+            return "Unknown message type";
+        case Ximu3DecoderResultInvalidEscape:
+            return "Invalid byte stuffing escape";
+        case Ximu3DecoderResultInvalidSize:
+            return "Invalid message size";
+        case Ximu3DecoderResultInvalidNumber:
+            return "Invalid number";
+        case Ximu3DecoderResultTooLong:
+            return "Message too long";
+    }
+    return ""; // avoid compiler warning
+}
+
+//------------------------------------------------------------------------------
+// End of file
@@ -0,0 +1,121 @@
+/**
+ * @file Ximu3Decoder.h
+ * @author Seb Madgwick
+ * @brief Decoder for the binary and ASCII data messages written by
+ * Ximu3Data.c. Binary messages are un-stuffed and all messages are dispatched
+ * on the first byte. Command responses are passed through as JSON strings.
+ */
+
+#ifndef XIMU3_DECODER_H
+#define XIMU3_DECODER_H
+
+//------------------------------------------------------------------------------
+// Includes
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "x-IMU3-Device/Ximu3Data.h"
+
+//------------------------------------------------------------------------------
+// Definitions
+
+/**
+ * @brief Maximum message size before un-stuffing, including the termination.
+ */
+#define XIMU3_DECODER_MAXIMUM_MESSAGE_SIZE (1024)
+
+/**
+ * @brief Message type.
+ */
+typedef enum {
+    Ximu3DecoderTypeInertial,
+    Ximu3DecoderTypeMagnetometer,
+    Ximu3DecoderTypeQuaternion,
+    Ximu3DecoderTypeRotationMatrix,
+    Ximu3DecoderTypeEulerAngles,
+    Ximu3DecoderTypeLinearAcceleration,
+    Ximu3DecoderTypeEarthAcceleration,
+    Ximu3DecoderTypeAhrsStatus,
+    Ximu3DecoderTypeHighGAccelerometer,
+    Ximu3DecoderTypeTemperature,
+    Ximu3DecoderTypeBattery,
+    Ximu3DecoderTypeRssi,
+    Ximu3DecoderTypeSerialAccessory,
+    Ximu3DecoderTypeNotification,
+    Ximu3DecoderTypeError,
+    Ximu3DecoderTypeCommand,
+} Ximu3DecoderType;
+
+/**
+ * @brief Result.
+ */
+typedef enum {
+    Ximu3DecoderResultOk,
+    Ximu3DecoderResultUnknownType,
+    Ximu3DecoderResultInvalidEscape,
+    Ximu3DecoderResultInvalidSize,
+    Ximu3DecoderResultInvalidNumber,
+    Ximu3DecoderResultTooLong,
+} Ximu3DecoderResult;
+
+/**
+ * @brief Decoded message. The data of the member for the type is valid. The
+ * serial accessory data, notification and error strings, and command JSON
+ * point to the message buffer.
+ */
+typedef struct {
+    Ximu3DecoderType type;
+    bool binary;
+
+    union {
+        Ximu3DataInertial inertial;
+        Ximu3DataMagnetometer magnetometer;
+        Ximu3DataQuaternion quaternion;
+        Ximu3DataRotationMatrix rotationMatrix;
+        Ximu3DataEulerAngles eulerAngles;
+        Ximu3DataLinearAcceleration linearAcceleration;
+        Ximu3DataEarthAcceleration earthAcceleration;
+        Ximu3DataAhrsStatus ahrsStatus;
+        Ximu3DataHighGAccelerometer highGAccelerometer;
+        Ximu3DataTemperature temperature;
+        Ximu3DataBattery battery;
+        Ximu3DataRssi rssi;
+        Ximu3DataSerialAccessory serialAccessory;
+        Ximu3DataNotification notification;
+        Ximu3DataError error;
+        const char* command;
+    } data;
+    char buffer[XIMU3_DECODER_MAXIMUM_MESSAGE_SIZE]; // private
+} Ximu3DecoderMessage;
+
+/**
+ * @brief Stream decoder. All structure members are private except for
+ * initialisation.
+ *
+ * Example:
+ * @code
+ * Ximu3Decoder decoder = {.message = Message, .error = Error};
+ * @endcode
+ */
+typedef struct {
+    void (*const message) (const Ximu3DecoderMessage * const message, void* const context);
+    void (*const error) (const Ximu3DecoderResult result, void* const context); // NULL if unused
+    void* const context;
+    uint8_t buffer[XIMU3_DECODER_MAXIMUM_MESSAGE_SIZE]; // private
+    size_t index; // private
+    bool discard; // private
+    Ximu3DecoderMessage decoded; // private
+} Ximu3Decoder;
+
+//------------------------------------------------------------------------------
+// Function declarations
+
+void Ximu3DecoderProcess(Ximu3Decoder * const decoder, const void* const data, const size_t numberOfBytes);
+Ximu3DecoderResult Ximu3DecoderParse(const void* const message, const size_t messageSize, Ximu3DecoderMessage * const decoded);
+const char* Ximu3DecoderResultToString(const Ximu3DecoderResult result);
+
+#endif
+
+//------------------------------------------------------------------------------
+// End of file
@@ -0,0 +1,54 @@
+/**
+ * @file definitions.h
+ * @author Seb Madgwick
+ * @brief Host stand-in for the definitions generated by MPLAB Harmony. Only
+ * the definitions used by the modules built for the host are provided.
+ */
+
+#ifndef DEFINITIONS_H
+#define DEFINITIONS_H
+
+//------------------------------------------------------------------------------
+// Includes
+
+#include <stdint.h>
+
+//------------------------------------------------------------------------------
+// Definitions
+
+/**
+ * @brief CPU clock frequency of the device.
+ */
+#define CPU_CLOCK_FREQUENCY (24000000U)
+
+/**
+ * @brief Reset cause. Each value is a different bit.
+ */
+typedef enum {
+    RCON_RESET_CAUSE_POR = 1 << 0,
+    RCON_RESET_CAUSE_BOR = 1 << 1,
+    RCON_RESET_CAUSE_IDLE = 1 << 2,
+    RCON_RESET_CAUSE_SLEEP = 1 << 3,
+    RCON_RESET_CAUSE_WDTO = 1 << 4,
+    RCON_RESET_CAUSE_SWR = 1 << 5,
+    RCON_RESET_CAUSE_EXTR = 1 << 6,
+    RCON_RESET_CAUSE_CMR = 1 << 7,
+    RCON_RESET_CAUSE_BCFGFAIL = 1 << 8,
+    RCON_RESET_CAUSE_BCFGERR = 1 << 9,
+    RCON_RESET_CAUSE_PORCORE = 1 << 10,
+    RCON_RESET_CAUSE_PORIO = 1 << 11,
+} RCON_RESET_CAUSE;
+
+//------------------------------------------------------------------------------
+// Function declarations
+
+void SYS_Initialize(void* data);
+void SYS_Tasks(void);
+RCON_RESET_CAUSE RCON_ResetCauseGet(void);
+void RCON_ResetCauseClear(RCON_RESET_CAUSE cause);
+uint32_t _CP0_GET_COUNT(void);
+
+#endif
+
+//------------------------------------------------------------------------------
+// End of file
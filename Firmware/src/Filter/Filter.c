@@ -0,0 +1,165 @@
+/**
+ * @file Filter.c
+ * @author Seb Madgwick
+ * @brief Median, decimation and low-pass filter pipeline for raw temperature
+ * codes. All arithmetic is fixed-point.
+ */
+
+//------------------------------------------------------------------------------
+// Includes
+
+#include "Filter.h"
+
+//------------------------------------------------------------------------------
+// Definitions
+
+/**
+ * @brief Number of fractional bits of the low-pass filter state.
+ */
+#define LOW_PASS_FRACTION_BITS (16)
+
+//------------------------------------------------------------------------------
+// Function declarations
+
+static int16_t Median(const int16_t input);
+static int32_t DivideRounded(const int32_t dividend, const int32_t divisor);
+
+//------------------------------------------------------------------------------
+// Variables
+
+const FilterSettings filterSettingsDefault = {
+    .medianSize = 1,
+    .decimation = 1,
+    .lowPassShift = 0,
+};
+
+static FilterSettings settings = {
+    .medianSize = 1,
+    .decimation = 1,
+    .lowPassShift = 0,
+};
+static int16_t medianHistory[FILTER_MAXIMUM_MEDIAN_SIZE];
+static uint32_t medianIndex;
+static uint32_t medianCount;
+static int32_t decimationSum;
+static uint32_t decimationCount;
+static int32_t lowPassState;
+static bool lowPassInitialised;
+
+//------------------------------------------------------------------------------
+// Functions
+
+/**
+ * @brief Sets the settings and resets the filter state. Invalid settings are
+ * modified to the nearest valid value.
+ * @param settings_ Settings.
+ */
+void FilterSetSettings(FilterSettings * const settings_) {
+
+    // Fix invalid settings
+    if (settings_->medianSize > FILTER_MAXIMUM_MEDIAN_SIZE) {
+        settings_->medianSize = FILTER_MAXIMUM_MEDIAN_SIZE;
+    }
+    if ((settings_->medianSize % 2) == 0) {
+        settings_->medianSize++;
+    }
+    if (settings_->decimation < 1) {
+        settings_->decimation = 1;
+    }
+    if (settings_->decimation > FILTER_MAXIMUM_DECIMATION) {
+        settings_->decimation = FILTER_MAXIMUM_DECIMATION;
+    }
+    if (settings_->lowPassShift > FILTER_MAXIMUM_LOW_PASS_SHIFT) {
+        settings_->lowPassShift = FILTER_MAXIMUM_LOW_PASS_SHIFT;
+    }
+    settings = *settings_;
+
+    // Reset state
+    medianIndex = 0;
+    medianCount = 0;
+    decimationSum = 0;
+    decimationCount = 0;
+    lowPassInitialised = false;
+}
+
+/**
+ * @brief Updates the filter with an input sample. The input is filtered by
+ * the median filter, then averaged by the decimation, then filtered by the
+ * low-pass filter.
+ * @param input Input sample.
+ * @param output Output sample. Only valid if the function returns true.
+ * @return True if an output sample is available.
+ */
+bool FilterUpdate(const int16_t input, int16_t * const output) {
+
+    // Median
+    const int16_t median = Median(input);
+
+    // Decimation
+    decimationSum += median;
+    if (++decimationCount < settings.decimation) {
+        return false;
+    }
+    const int32_t decimated = DivideRounded(decimationSum, (int32_t) settings.decimation);
+    decimationSum = 0;
+    decimationCount = 0;
+
+    // Low-pass
+    const int32_t scaled = decimated * (1 << LOW_PASS_FRACTION_BITS);
+    if (lowPassInitialised == false) {
+        lowPassState = scaled;
+        lowPassInitialised = true;
+    }
+    lowPassState += (int32_t) (((int64_t) scaled - lowPassState) >> settings.lowPassShift);
+    *output = (int16_t) (((int64_t) lowPassState + (1 << (LOW_PASS_FRACTION_BITS - 1))) >> LOW_PASS_FRACTION_BITS);
+    return true;
+}
+
+/**
+ * @brief Adds the input sample to the history and returns the median of the
+ * history. The median of the available samples is returned until the history
+ * is full.
+ * @param input Input sample.
+ * @return Median.
+ */
+static int16_t Median(const int16_t input) {
+    if (settings.medianSize == 1) {
+        return input;
+    }
+
+    // Add to history
+    medianHistory[medianIndex] = input;
+    medianIndex = (medianIndex + 1) % settings.medianSize;
+    if (medianCount < settings.medianSize) {
+        medianCount++;
+    }
+
+    // Insertion sort
+    int16_t sorted[FILTER_MAXIMUM_MEDIAN_SIZE];
+    for (uint32_t index = 0; index < medianCount; index++) {
+        const int16_t value = medianHistory[index];
+        uint32_t sortedIndex = index;
+        while ((sortedIndex > 0) && (sorted[sortedIndex - 1] > value)) {
+            sorted[sortedIndex] = sorted[sortedIndex - 1];
+            sortedIndex--;
+        }
+        sorted[sortedIndex] = value;
+    }
+    return sorted[medianCount / 2];
+}
+
+/**
+ * @brief Divides and rounds to nearest with ties away from zero.
+ * @param dividend Dividend.
+ * @param divisor Divisor. Must be greater than zero.
+ * @return Quotient.
+ */
+static int32_t DivideRounded(const int32_t dividend, const int32_t divisor) {
+    if (dividend < 0) {
+        return (dividend - (divisor / 2)) / divisor;
+    }
+    return (dividend + (divisor / 2)) / divisor;
+}
+
+//------------------------------------------------------------------------------
+// End of file
@@ -0,0 +1,62 @@
+/**
+ * @file Filter.h
+ * @author Seb Madgwick
+ * @brief Median, decimation and low-pass filter pipeline for raw temperature
+ * codes. All arithmetic is fixed-point.
+ */
+
+#ifndef FILTER_H
+#define FILTER_H
+
+//------------------------------------------------------------------------------
+// Includes
+
+#include <stdbool.h>
+#include <stdint.h>
+
+//------------------------------------------------------------------------------
+// Definitions
+
+/**
+ * @brief Maximum median size.
+ */
+#define FILTER_MAXIMUM_MEDIAN_SIZE (7)
+
+/**
+ * @brief Maximum decimation.
+ */
+#define FILTER_MAXIMUM_DECIMATION (256)
+
+/**
+ * @brief Maximum low-pass shift.
+ */
+#define FILTER_MAXIMUM_LOW_PASS_SHIFT (12)
+
+/**
+ * @brief Settings. The median size is the number of input samples of the
+ * median filter and must be odd. The decimation is the number of input
+ * samples averaged for each output sample. The low-pass shift determines the
+ * cutoff of the first-order IIR low-pass filter, 0 for no filtering. A value
+ * of 1 for the median size and decimation disables each stage.
+ */
+typedef struct {
+    uint32_t medianSize;
+    uint32_t decimation;
+    uint32_t lowPassShift;
+} FilterSettings;
+
+//------------------------------------------------------------------------------
+// Variable declarations
+
+extern const FilterSettings filterSettingsDefault;
+
+//------------------------------------------------------------------------------
+// Function declarations
+
+void FilterSetSettings(FilterSettings * const settings);
+bool FilterUpdate(const int16_t input, int16_t * const output);
+
+#endif
+
+//------------------------------------------------------------------------------
+// End of file
@@ -0,0 +1,91 @@
+/**
+ * @file Profile.c
+ * @author Seb Madgwick
+ * @brief Execution time profiling of named regions using the CP0 Count
+ * register.
+ */
+
+//------------------------------------------------------------------------------
+// Includes
+
+#include "Profile.h"
+#include <string.h>
+
+#ifdef PROFILE_ENABLED
+
+//------------------------------------------------------------------------------
+// Variables
+
+static ProfileStatistics statistics[ProfileRegionNumberOfRegions];
+
+//------------------------------------------------------------------------------
+// Functions
+
+/**
+ * @brief Adds a duration to the region statistics. This function should be
+ * called using PROFILE_STOP.
+ * @param region Region.
+ * @param ticks Duration in profile ticks.
+ */
+void ProfileAdd(const ProfileRegion region, const uint32_t ticks) {
+    ProfileStatistics * const regionStatistics = &statistics[region];
+    if ((ticks < regionStatistics->minimum) || (regionStatistics->count == 0)) {
+        regionStatistics->minimum = ticks;
+    }
+    if (ticks > regionStatistics->maximum) {
+        regionStatistics->maximum = ticks;
+    }
+    regionStatistics->count++;
+    regionStatistics->total += ticks;
+    int bin = ticks == 0 ? 0 : 32 - __builtin_clz(ticks);
+    if (bin >= PROFILE_HISTOGRAM_BINS) {
+        bin = PROFILE_HISTOGRAM_BINS - 1;
+    }
+    regionStatistics->histogram[bin]++;
+}
+
+/**
+ * @brief Returns the region statistics.
+ * @param region Region.
+ * @return Region statistics.
+ */
+const ProfileStatistics* ProfileGetStatistics(const ProfileRegion region) {
+    return &statistics[region];
+}
+
+/**
+ * @brief Resets the statistics of all regions.
+ */
+void ProfileReset(void) {
+    memset(statistics, 0, sizeof (statistics));
+}
+
+/**
+ * @brief Returns the region string.
+ * @param region Region.
+ * @return Region string.
+ */
+const char* ProfileRegionToString(const ProfileRegion region) {
+    switch (region) {
+        case ProfileRegionSysTasks:
+            return "sys_tasks";
+        case ProfileRegionI2C2Tasks:
+            return "i2c2_tasks";
+        case ProfileRegionUsbCdcTasks:
+            return "usb_cdc_tasks";
+        case ProfileRegionXimu3CommandTasks:
+            return "ximu3_command_tasks";
+        case ProfileRegionThermometerRead:
+            return "thermometer_read";
+        case ProfileRegionSendTemperature:
+            return "send_temperature";
+        case ProfileRegionNumberOfRegions:
+            break;
+    }
+    return ""; // avoid compiler warning
+}
+
+#endif
+
+//------------------------------------------------------------------------------
+// End of file
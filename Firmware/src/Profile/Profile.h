@@ -0,0 +1,96 @@
+/**
+ * @file Profile.h
+ * @author Seb Madgwick
+ * @brief Execution time profiling of named regions using the CP0 Count
+ * register.
+ */
+
+#ifndef PROFILE_H
+#define PROFILE_H
+
+//------------------------------------------------------------------------------
+// Includes
+
+#include "definitions.h"
+#include <stdint.h>
+
+//------------------------------------------------------------------------------
+// Definitions
+
+/**
+ * @brief Uncomment this line to enable profiling.
+ */
+//#define PROFILE_ENABLED
+
+/**
+ * @brief Profile ticks per second. The CP0 Count register increments every
+ * second CPU clock cycle.
+ */
+#define PROFILE_TICKS_PER_SECOND (CPU_CLOCK_FREQUENCY / 2)
+
+/**
+ * @brief Number of histogram bins. Bin 0 counts durations of 0 ticks and bin n
+ * counts durations of 2^(n-1) to (2^n)-1 ticks. The last bin also counts all
+ * longer durations.
+ */
+#define PROFILE_HISTOGRAM_BINS (16)
+
+/**
+ * @brief Region.
+ */
+typedef enum {
+    ProfileRegionSysTasks,
+    ProfileRegionI2C2Tasks,
+    ProfileRegionUsbCdcTasks,
+    ProfileRegionXimu3CommandTasks,
+    ProfileRegionThermometerRead,
+    ProfileRegionSendTemperature,
+    ProfileRegionNumberOfRegions,
+} ProfileRegion;
+
+/**
+ * @brief Statistics. Durations are in profile ticks.
+ */
+typedef struct {
+    uint32_t count;
+    uint32_t minimum;
+    uint32_t maximum;
+    uint64_t total;
+    uint32_t histogram[PROFILE_HISTOGRAM_BINS];
+} ProfileStatistics;
+
+/**
+ * @brief Starts a region. Must be followed by PROFILE_STOP for the same region
+ * within the same scope.
+ * @param region Region.
+ */
+#ifdef PROFILE_ENABLED
+#define PROFILE_START(region) const uint32_t profileStart##region = _CP0_GET_COUNT()
+#else
+#define PROFILE_START(region)
+#endif
+
+/**
+ * @brief Stops a region and adds the duration to the region statistics.
+ * @param region Region.
+ */
+#ifdef PROFILE_ENABLED
+#define PROFILE_STOP(region) ProfileAdd(region, _CP0_GET_COUNT() - profileStart##region)
+#else
+#define PROFILE_STOP(region)
+#endif
+
+//------------------------------------------------------------------------------
+// Function declarations
+
+#ifdef PROFILE_ENABLED
+void ProfileAdd(const ProfileRegion region, const uint32_t ticks);
+const ProfileStatistics* ProfileGetStatistics(const ProfileRegion region);
+void ProfileReset(void);
+const char* ProfileRegionToString(const ProfileRegion region);
+#endif
+
+#endif
+
+//------------------------------------------------------------------------------
+// End of file
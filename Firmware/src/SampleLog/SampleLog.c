@@ -0,0 +1,246 @@
+/**
+ * @file SampleLog.c
+ * @author Seb Madgwick
+ * @brief RAM log of temperature samples. Samples are stored in fixed-size
+ * blocks as a base timestamp and raw temperature followed by the deltas of
+ * each subsequent sample. The oldest block is overwritten when the log is
+ * full.
+ */
+
+//------------------------------------------------------------------------------
+// Includes
+
+#include "SampleLog.h"
+#include <string.h>
+
+//------------------------------------------------------------------------------
+// Definitions
+
+/**
+ * @brief Block size in bytes.
+ */
+#define BLOCK_SIZE (128)
+
+/**
+ * @brief Number of blocks. Must be a power of 2 so that the block index
+ * remains continuous when the sequence number overflows.
+ */
+#define NUMBER_OF_BLOCKS (SAMPLE_LOG_SIZE / BLOCK_SIZE)
+
+#if ((NUMBER_OF_BLOCKS & (NUMBER_OF_BLOCKS - 1)) != 0)
+#error "Number of blocks must be a power of two"
+#endif
+
+/**
+ * @brief Maximum number of bytes of a delta encoded sample. The timestamp and
+ * raw temperature deltas are each a variable-length integer of up to 5 bytes.
+ */
+#define MAXIMUM_SAMPLE_SIZE (10)
+
+/**
+ * @brief Block. Each sample after the first is encoded as the timestamp delta
+ * followed by the zigzag encoded raw temperature delta, both as little-endian
+ * base 128 variable-length integers.
+ */
+typedef struct {
+    uint64_t timestamp;
+    int16_t raw;
+    uint8_t numberOfSamples;
+    uint8_t numberOfBytes;
+    uint8_t deltas[BLOCK_SIZE - 12];
+} Block;
+
+//------------------------------------------------------------------------------
+// Function declarations
+
+static void NewBlock(const uint64_t timestamp, const int16_t raw);
+static uint32_t EncodeVarint(uint8_t * const destination, uint32_t value);
+static uint32_t DecodeVarint(const uint8_t * const source, uint32_t * const index);
+
+//------------------------------------------------------------------------------
+// Variables
+
+static Block blocks[NUMBER_OF_BLOCKS];
+static uint32_t firstSequence;
+static uint32_t numberOfBlocks;
+static uint32_t numberOfSamples;
+static uint64_t previousTimestamp;
+static int16_t previousRaw;
+
+//------------------------------------------------------------------------------
+// Functions
+
+/**
+ * @brief Writes a sample to the log. A new block is started if the sample
+ * cannot be delta encoded in the current block.
+ * @param timestamp Timestamp.
+ * @param raw Raw temperature.
+ */
+void SampleLogWrite(const uint64_t timestamp, const int16_t raw) {
+
+    // Start first block
+    if (numberOfBlocks == 0) {
+        NewBlock(timestamp, raw);
+        return;
+    }
+
+    // Start new block if timestamp not increasing or delta too large
+    Block * const block = &blocks[(firstSequence + numberOfBlocks - 1) % NUMBER_OF_BLOCKS];
+    if ((timestamp < previousTimestamp) || ((timestamp - previousTimestamp) > UINT32_MAX) || (block->numberOfSamples == UINT8_MAX)) {
+        NewBlock(timestamp, raw);
+        return;
+    }
+
+    // Encode deltas
+    uint8_t sample[MAXIMUM_SAMPLE_SIZE];
+    uint32_t sampleSize = EncodeVarint(sample, (uint32_t) (timestamp - previousTimestamp));
+    const int32_t rawDelta = (int32_t) raw - (int32_t) previousRaw;
+    sampleSize += EncodeVarint(&sample[sampleSize], ((uint32_t) rawDelta << 1) ^ (uint32_t) (rawDelta >> 31));
+
+    // Start new block if current block full
+    if ((block->numberOfBytes + sampleSize) > sizeof (block->deltas)) {
+        NewBlock(timestamp, raw);
+        return;
+    }
+
+    // Add sample to block
+    memcpy(&block->deltas[block->numberOfBytes], sample, sampleSize);
+    block->numberOfBytes += sampleSize;
+    block->numberOfSamples++;
+    numberOfSamples++;
+    previousTimestamp = timestamp;
+    previousRaw = raw;
+}
+
+/**
+ * @brief Starts a new block. The oldest block is overwritten if the log is
+ * full.
+ * @param timestamp Timestamp.
+ * @param raw Raw temperature.
+ */
+static void NewBlock(const uint64_t timestamp, const int16_t raw) {
+
+    // Overwrite oldest block if log full
+    if (numberOfBlocks == NUMBER_OF_BLOCKS) {
+        numberOfSamples -= blocks[firstSequence % NUMBER_OF_BLOCKS].numberOfSamples;
+        firstSequence++;
+        numberOfBlocks--;
+    }
+
+    // Initialise block
+    Block * const block = &blocks[(firstSequence + numberOfBlocks) % NUMBER_OF_BLOCKS];
+    block->timestamp = timestamp;
+    block->raw = raw;
+    block->numberOfSamples = 1;
+    block->numberOfBytes = 0;
+    numberOfBlocks++;
+    numberOfSamples++;
+    previousTimestamp = timestamp;
+    previousRaw = raw;
+}
+
+/**
+ * @brief Initialises a cursor to the oldest sample in the log.
+ * @param cursor Cursor.
+ */
+void SampleLogCursorInitialise(SampleLogCursor * const cursor) {
+    cursor->sequence = firstSequence;
+    cursor->sampleIndex = 0;
+    cursor->endSequence = firstSequence + numberOfBlocks - 1;
+    cursor->endSampleIndex = numberOfBlocks == 0 ? 0 : blocks[cursor->endSequence % NUMBER_OF_BLOCKS].numberOfSamples;
+}
+
+/**
+ * @brief Reads the next sample from the log.
+ * @param cursor Cursor.
+ * @param timestamp Timestamp.
+ * @param raw Raw temperature.
+ * @return True if a sample was read, false if there are no more samples.
+ */
+bool SampleLogRead(SampleLogCursor * const cursor, uint64_t * const timestamp, int16_t * const raw) {
+
+    // Find block containing next sample
+    const Block* block;
+    while (true) {
+
+        // Skip overwritten blocks
+        if ((int32_t) (cursor->sequence - firstSequence) < 0) {
+            cursor->sequence = firstSequence;
+            cursor->sampleIndex = 0;
+        }
+
+        // Do nothing if end reached
+        if ((int32_t) (cursor->sequence - cursor->endSequence) > 0) {
+            return false;
+        }
+
+        // Next block if end of block reached
+        block = &blocks[cursor->sequence % NUMBER_OF_BLOCKS];
+        const uint32_t blockNumberOfSamples = cursor->sequence == cursor->endSequence ? cursor->endSampleIndex : block->numberOfSamples;
+        if (cursor->sampleIndex < blockNumberOfSamples) {
+            break;
+        }
+        cursor->sequence++;
+        cursor->sampleIndex = 0;
+    }
+
+    // Decode sample
+    if (cursor->sampleIndex == 0) {
+        cursor->byteIndex = 0;
+        cursor->timestamp = block->timestamp;
+        cursor->raw = block->raw;
+    } else {
+        cursor->timestamp += DecodeVarint(block->deltas, &cursor->byteIndex);
+        const uint32_t rawDelta = DecodeVarint(block->deltas, &cursor->byteIndex);
+        cursor->raw += (int16_t) ((rawDelta >> 1) ^ -(rawDelta & 1));
+    }
+    cursor->sampleIndex++;
+    *timestamp = cursor->timestamp;
+    *raw = cursor->raw;
+    return true;
+}
+
+/**
+ * @brief Returns the number of samples in the log.
+ * @return Number of samples in the log.
+ */
+uint32_t SampleLogNumberOfSamples(void) {
+    return numberOfSamples;
+}
+
+/**
+ * @brief Encodes a variable-length integer.
+ * @param destination Destination.
+ * @param value Value.
+ * @return Number of bytes.
+ */
+static uint32_t EncodeVarint(uint8_t * const destination, uint32_t value) {
+    uint32_t index = 0;
+    while (value >= 0x80) {
+        destination[index++] = (value & 0x7F) | 0x80;
+        value >>= 7;
+    }
+    destination[index++] = value;
+    return index;
+}
+
+/**
+ * @brief Decodes a variable-length integer.
+ * @param source Source.
+ * @param index Index of the first byte. Incremented by the number of bytes.
+ * @return Value.
+ */
+static uint32_t DecodeVarint(const uint8_t * const source, uint32_t * const index) {
+    uint32_t value = 0;
+    int shift = 0;
+    uint8_t byte;
+    do {
+        byte = source[(*index)++];
+        value |= (uint32_t) (byte & 0x7F) << shift;
+        shift += 7;
+    } while ((byte & 0x80) != 0);
+    return value;
+}
+
+//------------------------------------------------------------------------------
+// End of file
@@ -0,0 +1,56 @@
+/**
+ * @file SampleLog.h
+ * @author Seb Madgwick
+ * @brief RAM log of temperature samples. Samples are stored in fixed-size
+ * blocks as a base timestamp and raw temperature followed by the deltas of
+ * each subsequent sample. The oldest block is overwritten when the log is
+ * full.
+ */
+
+#ifndef SAMPLE_LOG_H
+#define SAMPLE_LOG_H
+
+//------------------------------------------------------------------------------
+// Includes
+
+#include <stdbool.h>
+#include <stdint.h>
+
+//------------------------------------------------------------------------------
+// Definitions
+
+/**
+ * @brief Log size in bytes. Must be a power of two multiple of the block size.
+ * This value is a quarter of the device RAM and has not been sized against the
+ * linker map. If this value is increased then the stack usage should be
+ * checked using the stats command with PROFILE_ENABLED defined.
+ */
+#define SAMPLE_LOG_SIZE (8192)
+
+/**
+ * @brief Cursor for reading samples from the log. The cursor reads the samples
+ * that were in the log when the cursor was initialised. Samples that are
+ * overwritten before they are read are skipped.
+ */
+typedef struct {
+    uint32_t sequence; // private
+    uint32_t sampleIndex; // private
+    uint32_t byteIndex; // private
+    uint32_t endSequence; // private
+    uint32_t endSampleIndex; // private
+    uint64_t timestamp; // private
+    int16_t raw; // private
+} SampleLogCursor;
+
+//------------------------------------------------------------------------------
+// Function declarations
+
+void SampleLogWrite(const uint64_t timestamp, const int16_t raw);
+void SampleLogCursorInitialise(SampleLogCursor * const cursor);
+bool SampleLogRead(SampleLogCursor * const cursor, uint64_t * const timestamp, int16_t * const raw);
+uint32_t SampleLogNumberOfSamples(void);
+
+#endif
+
+//------------------------------------------------------------------------------
+// End of file
@@ -0,0 +1,167 @@
+/**
+ * @file Statistics.c
+ * @author Seb Madgwick
+ * @brief Main loop timing statistics.
+ */
+
+//------------------------------------------------------------------------------
+// Includes
+
+#include "definitions.h"
+#include "Statistics.h"
+#include <string.h>
+#include "Timer/Timer.h"
+
+//------------------------------------------------------------------------------
+// Definitions
+
+/**
+ * @brief Pattern written to the unused stack so that the stack high-water
+ * mark can be measured.
+ */
+#define STACK_PATTERN (0x5A5A5A5A)
+
+/**
+ * @brief Number of bytes below the stack pointer that are not written with the
+ * pattern.
+ */
+#define STACK_MARGIN (64)
+
+//------------------------------------------------------------------------------
+// Function declarations
+
+static void StackPaint(void);
+static size_t StackUsed(void);
+
+//------------------------------------------------------------------------------
+// Variables
+
+extern uint32_t _splim[]; // stack limit defined by the linker script
+extern uint32_t _stack[]; // stack start defined by the linker script
+
+static uint32_t previousTicks;
+static uint32_t windowStart;
+static uint32_t windowLoops;
+static Statistics statistics;
+
+//------------------------------------------------------------------------------
+// Functions
+
+/**
+ * @brief Initialises the module. This function should be called immediately
+ * before the main program loop.
+ */
+void StatisticsInitialise(void) {
+    previousTicks = TimerGetTicks32();
+    windowStart = previousTicks;
+    windowLoops = 0;
+    StatisticsReset();
+    StackPaint();
+}
+
+/**
+ * @brief Updates the loop statistics. This function should be called once per
+ * iteration of the main program loop.
+ */
+void StatisticsLoop(void) {
+
+    // Loop time
+    const uint32_t ticks = TimerGetTicks32();
+    const uint32_t loopTicks = ticks - previousTicks;
+    previousTicks = ticks;
+    if (loopTicks > statistics.maximumLoopTicks) {
+        statistics.maximumLoopTicks = loopTicks;
+    }
+
+    // Loops per second
+    windowLoops++;
+    if ((ticks - windowStart) >= TIMER_TICKS_PER_SECOND) {
+        statistics.loopsPerSecond = windowLoops;
+        windowLoops = 0;
+        windowStart += TIMER_TICKS_PER_SECOND;
+        if ((ticks - windowStart) >= TIMER_TICKS_PER_SECOND) {
+            windowStart = ticks; // loop stalled for longer than a second
+        }
+    }
+}
+
+/**
+ * @brief Adds the lateness of a periodic event. This function should be called
+ * when the event is serviced.
+ * @param event Event.
+ * @param deadline Deadline in timer ticks.
+ */
+void StatisticsDeadline(const StatisticsEvent event, const uint64_t deadline) {
+    const uint64_t ticks = TimerGetTicks64();
+    const uint32_t lateness = ticks > deadline ? (uint32_t) (ticks - deadline) : 0;
+    StatisticsLateness * const eventLateness = &statistics.lateness[event];
+    eventLateness->count++;
+    eventLateness->total += lateness;
+    if (lateness > eventLateness->maximum) {
+        eventLateness->maximum = lateness;
+    }
+}
+
+/**
+ * @brief Returns the statistics.
+ * @return Statistics.
+ */
+const Statistics* StatisticsGet(void) {
+    statistics.stackUsed = StackUsed();
+    statistics.stackSize = (size_t) ((uint8_t*) _stack - (uint8_t*) _splim);
+    return &statistics;
+}
+
+/**
+ * @brief Resets the maximum loop time and the lateness of all events.
+ */
+void StatisticsReset(void) {
+    statistics.maximumLoopTicks = 0;
+    memset(statistics.lateness, 0, sizeof (statistics.lateness));
+}
+
+/**
+ * @brief Returns the event string.
+ * @param event Event.
+ * @return Event string.
+ */
+const char* StatisticsEventToString(const StatisticsEvent event) {
+    switch (event) {
+        case StatisticsEventThermometerPoll:
+            return "thermometer_poll";
+        case StatisticsEventTemperatureOutput:
+            return "temperature_output";
+        case StatisticsEventNumberOfEvents:
+            break;
+    }
+    return ""; // avoid compiler warning
+}
+
+/**
+ * @brief Writes the pattern to the unused stack. Interrupts are disabled so
+ * that an interrupt stack frame is not overwritten.
+ */
+static void StackPaint(void) {
+    const bool interruptState = SYS_INT_Disable();
+    uint32_t* const end = (uint32_t*) ((uint8_t*) __builtin_frame_address(0) - STACK_MARGIN);
+    for (uint32_t* word = _splim; word < end; word++) {
+        *word = STACK_PATTERN;
+    }
+    SYS_INT_Restore(interruptState);
+}
+
+/**
+ * @brief Returns the stack high-water mark. This is the number of bytes of
+ * stack that have been used since the stack was painted.
+ * @return Stack high-water mark in bytes.
+ */
+static size_t StackUsed(void) {
+    const uint32_t* word = _splim;
+    while ((word < _stack) && (*word == STACK_PATTERN)) {
+        word++;
+    }
+    return (size_t) ((uint8_t*) _stack - (uint8_t*) word);
+}
+
+//------------------------------------------------------------------------------
+// End of file
@@ -0,0 +1,62 @@
+/**
+ * @file Statistics.h
+ * @author Seb Madgwick
+ * @brief Main loop timing statistics.
+ */
+
+#ifndef STATISTICS_H
+#define STATISTICS_H
+
+//------------------------------------------------------------------------------
+// Includes
+
+#include <stddef.h>
+#include <stdint.h>
+
+//------------------------------------------------------------------------------
+// Definitions
+
+/**
+ * @brief Periodic event.
+ */
+typedef enum {
+    StatisticsEventThermometerPoll,
+    StatisticsEventTemperatureOutput,
+    StatisticsEventNumberOfEvents,
+} StatisticsEvent;
+
+/**
+ * @brief Lateness of a periodic event relative to its deadline. Values are in
+ * timer ticks.
+ */
+typedef struct {
+    uint32_t count;
+    uint32_t maximum;
+    uint64_t total;
+} StatisticsLateness;
+
+/**
+ * @brief Statistics. Times are in timer ticks and stack sizes are in bytes.
+ */
+typedef struct {
+    uint32_t loopsPerSecond;
+    uint32_t maximumLoopTicks;
+    size_t stackUsed;
+    size_t stackSize;
+    StatisticsLateness lateness[StatisticsEventNumberOfEvents];
+} Statistics;
+
+//------------------------------------------------------------------------------
+// Function declarations
+
+void StatisticsInitialise(void);
+void StatisticsLoop(void);
+void StatisticsDeadline(const StatisticsEvent event, const uint64_t deadline);
+const Statistics* StatisticsGet(void);
+void StatisticsReset(void);
+const char* StatisticsEventToString(const StatisticsEvent event);
+
+#endif
+
+//------------------------------------------------------------------------------
+// End of file
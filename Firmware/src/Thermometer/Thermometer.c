@@ -8,17 +8,98 @@
 // Includes
 
 #include "I2C/I2C2.h"
+#include <math.h>
+#include "Statistics/Statistics.h"
 #include "Thermometer.h"
+#include "Timer/Timer.h"
 
 //------------------------------------------------------------------------------
 // Definitions
 
 #define I2C_ADDRESS (0x48)
 
+/**
+ * @brief Register addresses.
+ */
+#define TEMP_RESULT (0x00)
+#define CONFIGURATION (0x01)
+#define DEVICE_ID_1 (0x06)
+#define DEVICE_ID_2 (0x08)
+
+/**
+ * @brief Configuration register bits.
+ */
+#define DATA_READY (1 << 13)
+#define MOD_CONTINUOUS_CONVERSION (0b00 << 10)
+#define CONV_POSITION (7)
+#define AVG_POSITION (5)
+#define DR_ALERT (1 << 2)
+
+/**
+ * @brief Data ready poll interval in timer ticks. The ALERT pin is not
+ * connected to the MCU and so the data ready flag must be polled. This value
+ * determines the maximum latency of the sample timestamp.
+ */
+#define POLL_INTERVAL (TIMER_TICKS_PER_MILLISECOND)
+
+/**
+ * @brief Fraction of the conversion period after a conversion result during
+ * which the data ready flag is not polled. The remainder of the period allows
+ * for the tolerance of the TMP117 oscillator.
+ */
+#define POLL_HOLDOFF_NUMERATOR (7)
+#define POLL_HOLDOFF_DENOMINATOR (8)
+
 //------------------------------------------------------------------------------
 // Function declarations
 
+static void ConfigurationCallback(const I2CTransferResult result, void* const context);
+static void TemperatureCallback(const I2CTransferResult result, void* const context);
+static uint32_t ConversionPeriod(const ThermometerSettings * const settings);
 static uint16_t ReadRegister(const uint8_t address);
+static void WriteRegister(const uint8_t address, const uint16_t value);
+
+//------------------------------------------------------------------------------
+// Variables
+
+const ThermometerSettings thermometerSettingsDefault = {
+    .conversionCycle = ThermometerConversionCycle1s,
+    .averaging = ThermometerAveraging64,
+};
+
+/**
+ * @brief Conversion cycle and averaging times in microseconds. See table 7-7
+ * of the TMP117 datasheet.
+ */
+static const uint32_t conversionCycleTimes[] = {15500, 125000, 250000, 500000, 1000000, 4000000, 8000000, 16000000};
+static const uint32_t averagingTimes[] = {15500, 125000, 500000, 1000000};
+
+static const uint8_t configurationAddress = CONFIGURATION;
+static uint8_t configurationData[2];
+static I2CTransfer configurationTransfer = {
+    .address = I2C_ADDRESS,
+    .writeData = &configurationAddress,
+    .numberOfWriteBytes = sizeof (configurationAddress),
+    .readData = configurationData,
+    .numberOfReadBytes = sizeof (configurationData),
+    .callback = ConfigurationCallback,
+};
+static const uint8_t temperatureAddress = TEMP_RESULT;
+static uint8_t temperatureData[2];
+static I2CTransfer temperatureTransfer = {
+    .address = I2C_ADDRESS,
+    .writeData = &temperatureAddress,
+    .numberOfWriteBytes = sizeof (temperatureAddress),
+    .readData = temperatureData,
+    .numberOfReadBytes = sizeof (temperatureData),
+    .callback = TemperatureCallback,
+};
+static uint64_t pollTimeout;
+static uint64_t dataReadyTicks;
+static uint64_t pollHoldoff;
+static volatile bool transferInProgress;
+static volatile bool dataAvailable;
+static ThermometerData latestData;
 
 //------------------------------------------------------------------------------
 // Functions
@@ -26,9 +107,149 @@ static uint16_t ReadRegister(const uint8_t address);
 /**
  * @brief Initialises the module. This function must only be called once, on
  * system startup.
+ * @param settings Settings.
  */
-void ThermometerInitialise(void) {
+void ThermometerInitialise(const ThermometerSettings * const settings) {
     I2C2Initialise(I2CClockFrequency400kHz);
+    ThermometerSetSettings(settings);
+}
+
+/**
+ * @brief Sets the settings. The TMP117 is reconfigured once any queued
+ * transfers are complete. This function blocks until the transfer is
+ * complete.
+ * @param settings Settings.
+ */
+void ThermometerSetSettings(const ThermometerSettings * const settings) {
+
+    // Configure continuous conversion mode with ALERT pin as data ready
+    WriteRegister(CONFIGURATION, MOD_CONTINUOUS_CONVERSION | (settings->conversionCycle << CONV_POSITION) | (settings->averaging << AVG_POSITION) | DR_ALERT);
+
+    // Schedule first poll
+    pollHoldoff = ((uint64_t) ConversionPeriod(settings) * TIMER_TICKS_PER_MICROSECOND * POLL_HOLDOFF_NUMERATOR) / POLL_HOLDOFF_DENOMINATOR;
+    pollTimeout = TimerGetTicks64() + POLL_INTERVAL;
+}
+
+/**
+ * @brief Returns the settings for the conversion rate nearest to the
+ * specified rate. The averaging is the largest that does not increase the
+ * conversion period. Rates less than or equal to zero select the slowest
+ * conversion rate. Rates that are not finite or greater than the fastest
+ * conversion rate select the fastest conversion rate.
+ * @param rate Rate in Hz.
+ * @return Settings.
+ */
+ThermometerSettings ThermometerSettingsFromRate(const float rate) {
+    if ((isfinite(rate) == false) || (rate >= (1E6f / (float) conversionCycleTimes[ThermometerConversionCycle15ms5]))) {
+        const ThermometerSettings fastest = {
+            .conversionCycle = ThermometerConversionCycle15ms5,
+            .averaging = ThermometerAveragingNone,
+        };
+        return fastest;
+    }
+    ThermometerSettings nearest = {
+        .conversionCycle = ThermometerConversionCycle16s,
+        .averaging = ThermometerAveraging64,
+    };
+    if (rate <= 0.0f) {
+        return nearest;
+    }
+    float nearestError = INFINITY;
+    for (ThermometerConversionCycle conversionCycle = 0; conversionCycle <= ThermometerConversionCycle16s; conversionCycle++) {
+        ThermometerSettings settings = {.conversionCycle = conversionCycle};
+        for (ThermometerAveraging averaging = 0; averaging <= ThermometerAveraging64; averaging++) {
+            if (averagingTimes[averaging] <= conversionCycleTimes[conversionCycle]) {
+                settings.averaging = averaging;
+            }
+        }
+        const float ratio = rate / ThermometerSettingsToRate(&settings);
+        const float error = ratio > 1.0f ? ratio : 1.0f / ratio; // ratio error is symmetrical on a log scale
+        if (error < nearestError) {
+            nearest = settings;
+            nearestError = error;
+        }
+    }
+    return nearest;
+}
+
+/**
+ * @brief Returns the conversion rate of the settings.
+ * @param settings Settings.
+ * @return Rate in Hz.
+ */
+float ThermometerSettingsToRate(const ThermometerSettings * const settings) {
+    return 1E6f / (float) ConversionPeriod(settings);
+}
+
+/**
+ * @brief Returns the conversion period. This is the conversion cycle time or
+ * the averaging time if it is longer.
+ * @param settings Settings.
+ * @return Conversion period in microseconds.
+ */
+static uint32_t ConversionPeriod(const ThermometerSettings * const settings) {
+    const uint32_t conversionCycleTime = conversionCycleTimes[settings->conversionCycle];
+    const uint32_t averagingTime = averagingTimes[settings->averaging];
+    return averagingTime > conversionCycleTime ? averagingTime : conversionCycleTime;
+}
+
+/**
+ * @brief Reads the result of the latest conversion. The data ready flag is
+ * polled using non-blocking I2C transfers. Polling is paced by the conversion
+ * period so that the flag is only polled close to the end of each conversion.
+ * The timestamp is the time that the data ready flag was read.
+ * @param data Data.
+ * @return True if a new conversion result was read.
+ */
+bool ThermometerRead(ThermometerData * const data) {
+
+    // Get data before a new transfer is started
+    const bool newData = dataAvailable;
+    if (newData) {
+        *data = latestData;
+        dataAvailable = false;
+        pollTimeout = data->ticks + pollHoldoff;
+    }
+
+    // Poll data ready flag
+    const uint64_t ticks = TimerGetTicks64();
+    if ((transferInProgress == false) && (ticks >= pollTimeout)) {
+        StatisticsDeadline(StatisticsEventThermometerPoll, pollTimeout);
+        pollTimeout = ticks + POLL_INTERVAL;
+        transferInProgress = I2C2Transfer(&configurationTransfer);
+    }
+    return newData;
+}
+
+/**
+ * @brief Configuration register transfer callback. Reading the configuration
+ * register clears the data ready flag. The timestamp is captured here rather
+ * than when the poll was started because the transfer may have been queued
+ * behind other transfers.
+ * @param result Result.
+ * @param context Context.
+ */
+static void ConfigurationCallback(const I2CTransferResult result, void* const context) {
+    if ((result == I2CTransferResultOk) && ((configurationData[0] << 8) & DATA_READY)) {
+        dataReadyTicks = TimerGetTicks64();
+        transferInProgress = I2C2Transfer(&temperatureTransfer);
+        return;
+    }
+    transferInProgress = false;
+}
+
+/**
+ * @brief Temperature register transfer callback.
+ * @param result Result.
+ * @param context Context.
+ */
+static void TemperatureCallback(const I2CTransferResult result, void* const context) {
+    if (result == I2CTransferResultOk) {
+        latestData.ticks = dataReadyTicks;
+        latestData.raw = (int16_t) (((uint16_t) temperatureData[0] << 8) | (uint16_t) temperatureData[1]);
+        dataAvailable = true;
+    }
+    transferInProgress = false;
 }
 
 /**
@@ -36,7 +257,16 @@ void ThermometerInitialise(void) {
  * @return Temperature in degree Celsius.
  */
 float ThermometerReadTemperature(void) {
-    return ((float) ReadRegister(0x00)) * 0.0078125f;
+    return ThermometerRawToTemperature((int16_t) ReadRegister(TEMP_RESULT));
+}
+
+/**
+ * @brief Converts a raw temperature to degree Celsius.
+ * @param raw Raw temperature in units of 1/128 degree Celsius.
+ * @return Temperature in degree Celsius.
+ */
+float ThermometerRawToTemperature(const int16_t raw) {
+    return (float) raw * 0.0078125f;
 }
 
 /**
@@ -44,13 +274,14 @@ float ThermometerReadTemperature(void) {
  * @return Unique ID.
  */
 uint32_t ThermometerReadUniqueId(void) {
-    const uint16_t upperWord = ReadRegister(0x06);
-    const uint16_t lowerWord = ReadRegister(0x08);
+    const uint16_t upperWord = ReadRegister(DEVICE_ID_1);
+    const uint16_t lowerWord = ReadRegister(DEVICE_ID_2);
     return ((uint32_t) upperWord << 16) | (uint32_t) lowerWord;
 }
 
 /**
- * @brief Reads a register.
+ * @brief Reads a register. This function blocks until the transfer is
+ * complete.
  * @param address Register address.
  * @return Register value.
  */
@@ -66,5 +297,20 @@ static uint16_t ReadRegister(const uint8_t address) {
     return ((uint16_t) msb << 8) | (uint16_t) lsb;
 }
 
+/**
+ * @brief Writes a register. This function blocks until the transfer is
+ * complete.
+ * @param address Register address.
+ * @param value Register value.
+ */
+static void WriteRegister(const uint8_t address, const uint16_t value) {
+    I2C2Start();
+    I2C2Send(I2CAddressWrite(I2C_ADDRESS));
+    I2C2Send(address);
+    I2C2Send(value >> 8);
+    I2C2Send(value & 0xFF);
+    I2C2Stop();
+}
+
 //------------------------------------------------------------------------------
 // End of file
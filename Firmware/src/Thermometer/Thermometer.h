@@ -10,13 +10,70 @@
 //------------------------------------------------------------------------------
 // Includes
 
+#include <stdbool.h>
 #include <stdint.h>
 
+//------------------------------------------------------------------------------
+// Definitions
+
+/**
+ * @brief Conversion cycle. Values equal to CONV bits of the configuration
+ * register. The actual conversion cycle will be longer than specified if the
+ * averaging time is longer. See table 7-7 of the TMP117 datasheet.
+ */
+typedef enum {
+    ThermometerConversionCycle15ms5,
+    ThermometerConversionCycle125ms,
+    ThermometerConversionCycle250ms,
+    ThermometerConversionCycle500ms,
+    ThermometerConversionCycle1s,
+    ThermometerConversionCycle4s,
+    ThermometerConversionCycle8s,
+    ThermometerConversionCycle16s,
+} ThermometerConversionCycle;
+
+/**
+ * @brief Averaging. Values equal to AVG bits of the configuration register.
+ */
+typedef enum {
+    ThermometerAveragingNone,
+    ThermometerAveraging8,
+    ThermometerAveraging32,
+    ThermometerAveraging64,
+} ThermometerAveraging;
+
+/**
+ * @brief Settings.
+ */
+typedef struct {
+    ThermometerConversionCycle conversionCycle;
+    ThermometerAveraging averaging;
+} ThermometerSettings;
+
+/**
+ * @brief Data. The raw temperature is the temperature register value in units
+ * of 1/128 degree Celsius.
+ */
+typedef struct {
+    uint64_t ticks;
+    int16_t raw;
+} ThermometerData;
+
+//------------------------------------------------------------------------------
+// Variable declarations
+
+extern const ThermometerSettings thermometerSettingsDefault;
+
 //------------------------------------------------------------------------------
 // Function declarations
 
-void ThermometerInitialise(void);
+void ThermometerInitialise(const ThermometerSettings * const settings);
+void ThermometerSetSettings(const ThermometerSettings * const settings);
+ThermometerSettings ThermometerSettingsFromRate(const float rate);
+float ThermometerSettingsToRate(const ThermometerSettings * const settings);
+bool ThermometerRead(ThermometerData * const data);
 float ThermometerReadTemperature(void);
+float ThermometerRawToTemperature(const int16_t raw);
 uint32_t ThermometerReadUniqueId(void);
 
 #endif
@@ -7,13 +7,67 @@
 //------------------------------------------------------------------------------
 // Includes
 
+#include <stdbool.h>
 #include "Timer/Timer.h"
 #include "Timestamp.h"
 
+//------------------------------------------------------------------------------
+// Definitions
+
+/**
+ * @brief Reciprocal of TIMER_TICKS_PER_MICROSECOND as a 0.64 fixed-point
+ * value, rounded down.
+ */
+#define RECIPROCAL (UINT64_MAX / TIMER_TICKS_PER_MICROSECOND)
+
+/**
+ * @brief Number of fractional bits of the rate correction.
+ */
+#define RATE_Q (24)
+
+/**
+ * @brief Maximum rate correction. Equal to the worst-case crystal tolerance.
+ * Limiting the rate to a small fraction ensures that the timestamp is
+ * monotonic while slewing.
+ */
+#define MAXIMUM_RATE (500e-6f)
+
+/**
+ * @brief Synchronisation error in microseconds above which the timestamp is
+ * stepped instead of slewed.
+ */
+#define STEP_THRESHOLD (1000000)
+
+/**
+ * @brief Proportional gain of the synchronisation servo. A gain of 1 would
+ * remove the error over one synchronisation interval.
+ */
+#define PROPORTIONAL_GAIN (0.5f)
+
+/**
+ * @brief Integral gain of the synchronisation servo.
+ */
+#define INTEGRAL_GAIN (0.1f)
+
+//------------------------------------------------------------------------------
+// Function declarations
+
+static void Step(const uint64_t timestamp, const uint64_t microseconds);
+static uint64_t Corrected(const uint64_t microseconds);
+static inline __attribute__((always_inline)) uint64_t Microseconds(const uint64_t ticks);
+static inline __attribute__((always_inline)) uint64_t MultiplyHigh(const uint64_t a, const uint64_t b);
+static float Clamp(const float value);
+
 //------------------------------------------------------------------------------
 // Variables
 
-static uint64_t offset;
+static uint64_t baseTimestamp;
+static uint64_t baseMicroseconds;
+static int32_t rate;
+static bool synchronised;
+static uint64_t referenceMicroseconds;
+static float skew;
+static int64_t residual;
 
 //------------------------------------------------------------------------------
 // Functions
@@ -27,11 +81,65 @@ uint64_t TimestampGet(void) {
 }
 
 /**
- * @brief Sets the current timestamp.
+ * @brief Sets the current timestamp. The timestamp is stepped and the
+ * estimated skew is retained.
  * @param timestamp Timestamp.
  */
 void TimestampSet(const uint64_t timestamp) {
-    offset += timestamp - TimestampGet();
+    Step(timestamp, Microseconds(TimerGetTicks64()));
+}
+
+/**
+ * @brief Synchronises the timestamp to a reference time. This function should
+ * be called each time a reference time is received. The first reference, or a
+ * reference with an error greater than STEP_THRESHOLD, steps the timestamp.
+ * Subsequent references update the estimated skew and the timestamp is slewed
+ * so that it remains monotonic.
+ * @param timestamp Reference timestamp.
+ */
+void TimestampSynchronise(const uint64_t timestamp) {
+    const uint64_t microseconds = Microseconds(TimerGetTicks64());
+    const uint64_t current = Corrected(microseconds);
+    residual = (int64_t) (timestamp - current);
+
+    // Step if first reference or error too large
+    if ((synchronised == false) || (residual > STEP_THRESHOLD) || (residual < -STEP_THRESHOLD)) {
+        synchronised = true;
+        skew = 0.0f;
+        Step(timestamp, microseconds);
+        return;
+    }
+
+    // Update servo
+    if (microseconds <= referenceMicroseconds) {
+        return;
+    }
+    const float error = (float) residual / (float) (microseconds - referenceMicroseconds);
+    skew = Clamp(skew + (INTEGRAL_GAIN * error));
+    rate = (int32_t) (Clamp(skew + (PROPORTIONAL_GAIN * error)) * (float) (1 << RATE_Q));
+
+    // Continue from current timestamp
+    baseTimestamp = current;
+    baseMicroseconds = microseconds;
+    referenceMicroseconds = microseconds;
+}
+
+/**
+ * @brief Returns the estimated skew of the local clock relative to the
+ * reference in ppm.
+ * @return Estimated skew in ppm.
+ */
+float TimestampGetSkew(void) {
+    return skew * 1e6f;
+}
+
+/**
+ * @brief Returns the error between the reference and the timestamp in
+ * microseconds at the latest synchronisation.
+ * @return Residual in microseconds.
+ */
+int64_t TimestampGetResidual(void) {
+    return residual;
 }
 
 /**
@@ -40,7 +148,82 @@ void TimestampSet(const uint64_t timestamp) {
  * @return Timestamp.
  */
 uint64_t TimestampFrom(const uint64_t ticks) {
-    return offset + (ticks / TIMER_TICKS_PER_MICROSECOND);
+    return Corrected(Microseconds(ticks));
+}
+
+/**
+ * @brief Steps the timestamp and sets the rate to the estimated skew.
+ * @param timestamp Timestamp.
+ * @param microseconds Local microseconds.
+ */
+static void Step(const uint64_t timestamp, const uint64_t microseconds) {
+    baseTimestamp = timestamp;
+    baseMicroseconds = microseconds;
+    referenceMicroseconds = microseconds;
+    rate = (int32_t) (skew * (float) (1 << RATE_Q));
+}
+
+/**
+ * @brief Returns the timestamp corrected for the rate since the base.
+ * @param microseconds Local microseconds.
+ * @return Timestamp.
+ */
+static uint64_t Corrected(const uint64_t microseconds) {
+    const int64_t elapsed = (int64_t) (microseconds - baseMicroseconds);
+    return baseTimestamp + elapsed + ((elapsed * rate) >> RATE_Q);
+}
+
+/**
+ * @brief Returns the local microseconds. The division by
+ * TIMER_TICKS_PER_MICROSECOND is implemented as a multiplication by the
+ * reciprocal to avoid the 64-bit software division. The reciprocal is rounded
+ * down so the estimated quotient is at most one less than the exact quotient
+ * and is corrected using the remainder. The result is identical to the
+ * division for all values.
+ * @param ticks Timer ticks.
+ * @return Local microseconds.
+ */
+static inline __attribute__((always_inline)) uint64_t Microseconds(const uint64_t ticks) {
+    uint64_t quotient = MultiplyHigh(ticks, RECIPROCAL);
+    if ((ticks - (quotient * TIMER_TICKS_PER_MICROSECOND)) >= TIMER_TICKS_PER_MICROSECOND) {
+        quotient++;
+    }
+    return quotient;
+}
+
+/**
+ * @brief Returns the upper 64 bits of the 128-bit product using 32-bit
+ * multiplications.
+ * @param a A.
+ * @param b B.
+ * @return Upper 64 bits of the 128-bit product.
+ */
+static inline __attribute__((always_inline)) uint64_t MultiplyHigh(const uint64_t a, const uint64_t b) {
+    const uint64_t aLow = (uint32_t) a;
+    const uint64_t aHigh = a >> 32;
+    const uint64_t bLow = (uint32_t) b;
+    const uint64_t bHigh = b >> 32;
+    const uint64_t lowLow = aLow * bLow;
+    const uint64_t lowHigh = aLow * bHigh;
+    const uint64_t highLow = aHigh * bLow;
+    const uint64_t highHigh = aHigh * bHigh;
+    const uint64_t middle = (lowLow >> 32) + (uint32_t) lowHigh + (uint32_t) highLow;
+    return highHigh + (lowHigh >> 32) + (highLow >> 32) + (middle >> 32);
+}
+
+/**
+ * @brief Limits the value to +/- MAXIMUM_RATE.
+ * @param value Value.
+ * @return Limited value.
+ */
+static float Clamp(const float value) {
+    if (value > MAXIMUM_RATE) {
+        return MAXIMUM_RATE;
+    }
+    if (value < -MAXIMUM_RATE) {
+        return -MAXIMUM_RATE;
+    }
+    return value;
 }
 
 //------------------------------------------------------------------------------
@@ -17,6 +17,9 @@
 
 uint64_t TimestampGet(void);
 void TimestampSet(const uint64_t timestamp);
+void TimestampSynchronise(const uint64_t timestamp);
+float TimestampGetSkew(void);
+int64_t TimestampGetResidual(void);
 uint64_t TimestampFrom(const uint64_t ticks);
 
 #endif
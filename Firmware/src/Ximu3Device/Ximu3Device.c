@@ -7,32 +7,110 @@
 //------------------------------------------------------------------------------
 // Includes
 
+#include "Filter/Filter.h"
+#include <inttypes.h>
+#include <stdarg.h>
 #include "Led/Led.h"
+#include "Profile/Profile.h"
+#include "SampleLog/SampleLog.h"
+#include "Statistics/Statistics.h"
 #include <stdint.h>
 #include <stdio.h>
+#include <string.h>
 #include "Thermometer/Thermometer.h"
 #include "Timer/Timer.h"
 #include "Timestamp/Timestamp.h"
 #include "Usb/UsbCdc.h"
 #include "x-IMU3-Device/Ximu3.h"
 
+//------------------------------------------------------------------------------
+// Definitions
+
+/**
+ * @brief Size of the buffer for data messages pending while the write buffer
+ * is full.
+ */
+#define PENDING_SIZE (512)
+
+/**
+ * @brief Minimum write buffer space required to send each downloaded sample.
+ */
+#define DOWNLOAD_SPACE (64)
+
+/**
+ * @brief Data output policy when a data message cannot be written because the
+ * write buffer is full.
+ */
+typedef enum {
+    DataOutputPolicyDropNewest, // message is discarded
+    DataOutputPolicyDropOldest, // message is pending and the oldest pending messages are discarded if there is not enough space
+    DataOutputPolicyCoalesce, // message is pending and replaces any pending message of the same type
+} DataOutputPolicy;
+
+/**
+ * @brief Data output. Data messages are newline terminated in both ASCII and binary
+ * mode and so pending messages are delimited by newline characters.
+ */
+typedef struct {
+    DataOutputPolicy policy;
+    size_t (*const availableWrite)(void);
+    FifoResult(*const write)(const void* const data, const size_t numberOfBytes);
+    char pending[PENDING_SIZE];
+    size_t pendingSize;
+    uint32_t droppedMessages;
+    uint32_t droppedBytes;
+} DataOutput;
+
+/**
+ * @brief Data message encoder.
+ */
+typedef size_t(*DataEncode) (void* const destination, const size_t destinationSize, const void* const data);
+
 //------------------------------------------------------------------------------
 // Function declarations
 
 static size_t UsbRead(void* const destination, size_t numberOfBytes, void* const context);
 static void UsbWrite(const void* const data, const size_t numberOfBytes, void* const context);
+static void UsbWritePointer(void* * const pointer, size_t * const numberOfBytes, void* const context);
+static void UsbWritePointerComplete(const size_t numberOfBytes, void* const context);
+static void UsbReadPointer(void* * const pointer, size_t * const numberOfBytes, void* const context);
+static void UsbReadPointerComplete(const size_t numberOfBytes, void* const context);
 static void Ping(const char* * const value, Ximu3CommandResponse * const response, void* const context);
 static void Blink(const char* * const value, Ximu3CommandResponse * const response, void* const context);
 static void Strobe(const char* * const value, Ximu3CommandResponse * const response, void* const context);
 static void Note(const char* * const value, Ximu3CommandResponse * const response, void* const context);
 static void Timestamp(const char* * const value, Ximu3CommandResponse * const response, void* const context);
+static void TimestampSync(const char* * const value, Ximu3CommandResponse * const response, void* const context);
+static void Output(const char* * const value, Ximu3CommandResponse * const response, void* const context);
+static void Stats(const char* * const value, Ximu3CommandResponse * const response, void* const context);
+static void StatsReset(const char* * const value, Ximu3CommandResponse * const response, void* const context);
+static void Download(const char* * const value, Ximu3CommandResponse * const response, void* const context);
+#ifdef PROFILE_ENABLED
+static void Profile(const char* * const value, Ximu3CommandResponse * const response, void* const context);
+static void ProfileResetCommand(const char* * const value, Ximu3CommandResponse * const response, void* const context);
+#endif
+static void WriteEpilogue(const Ximu3SettingsIndex index, void* const context);
+static void ApplyTemperatureRate(void);
+static void ApplyFilterSettings(void);
 static void Error(const char* const error, void* const context);
+static void DownloadTasks(void);
+static void UsbWriteData(const DataEncode encode, const void* const data);
+static size_t EncodeNotification(void* const destination, const size_t destinationSize, const void* const data);
+static size_t EncodeError(void* const destination, const size_t destinationSize, const void* const data);
+static size_t EncodeTemperature(void* const destination, const size_t destinationSize, const void* const data);
+static void DataOutputTasks(DataOutput * const output);
+static void DataOutputWrite(DataOutput * const output, const char* const message, const size_t numberOfBytes);
+static size_t MessageSize(const char* const messages, const size_t numberOfBytes);
+static void RemoveMessage(DataOutput * const output, const size_t index, const size_t numberOfBytes);
+static void Drop(DataOutput * const output, const size_t numberOfBytes);
+static const char* PolicyToString(const DataOutputPolicy policy);
+static void ResponseAppend(Ximu3CommandResponse * const response, size_t * const index, const char* const format, ...) __attribute__((format(printf, 3, 4)));
 
 //------------------------------------------------------------------------------
 // Variables
 
 static Ximu3CommandInterface interfaces[] = {
-    { .name = "USB", .read = UsbRead, .write = UsbWrite},
+    { .name = "USB", .read = UsbRead, .write = UsbWrite, .writePointer = UsbWritePointer, .writePointerComplete = UsbWritePointerComplete, .readPointer = UsbReadPointer, .readPointerComplete = UsbReadPointerComplete},
 };
 
 static const Ximu3CommandMap commands[] = {
@@ -41,25 +119,77 @@ static const Ximu3CommandMap commands[] = {
     {"strobe", Strobe},
     {"note", Note},
     {"timestamp", Timestamp},
+    {"timestamp_sync", TimestampSync},
+    {"output", Output},
+    {"stats", Stats},
+    {"stats_reset", StatsReset},
+    {"download", Download},
+#ifdef PROFILE_ENABLED
+    {"profile", Profile},
+    {"profile_reset", ProfileResetCommand},
+#endif
 };
 
+static Ximu3Settings settings;
+
 static Ximu3CommandBridge bridge = {
     .interfaces = interfaces,
     .numberOfInterfaces = sizeof (interfaces) / sizeof (Ximu3CommandInterface),
     .commands = commands,
     .numberOfCommands = sizeof (commands) / sizeof (Ximu3CommandMap),
+    .settings = &settings,
+    .writeEpilogue = WriteEpilogue,
     .error = Error,
 };
 
+static DataOutput usbOutput = {
+    .policy = DataOutputPolicyDropNewest,
+    .availableWrite = UsbCdcAvailableWrite,
+    .write = UsbCdcWrite,
+};
+
+static SampleLogCursor downloadCursor;
+static bool downloadInProgress;
+static bool downloadAll;
+static uint64_t downloadAfter;
+static uint32_t downloadCount;
+
 //------------------------------------------------------------------------------
 // Functions
 
+/**
+ * @brief Initialises the module. This function must only be called once, on
+ * system startup. Settings are not stored in NVM and so the defaults are
+ * loaded.
+ */
+void Ximu3DeviceInitialise(void) {
+    Ximu3SettingsInitialise(&settings);
+    Ximu3SettingsLoadDefaults(&settings, true);
+    ApplyTemperatureRate();
+    ApplyFilterSettings();
+}
+
 /**
  * @brief Module tasks. This function should be called repeatedly within the
  * main program loop.
  */
 void Ximu3DeviceTasks(void) {
+    PROFILE_START(ProfileRegionXimu3CommandTasks);
     Ximu3CommandTasks(&bridge);
+    PROFILE_STOP(ProfileRegionXimu3CommandTasks);
+    DataOutputTasks(&usbOutput);
+    DownloadTasks();
+}
+
+/**
+ * @brief Sends temperature data message if USB data messages are enabled.
+ * @param data Data.
+ */
+void Ximu3DeviceSendTemperature(const Ximu3DataTemperatureFixed * const data) {
+    if (Ximu3SettingsGet(&settings)->usbDataMessagesEnabled == false) {
+        return;
+    }
+    UsbWriteData(EncodeTemperature, data);
 }
 
 /**
@@ -83,6 +213,46 @@ void UsbWrite(const void* const data, const size_t numberOfBytes, void* const co
     UsbCdcWrite(data, numberOfBytes);
 }
 
+/**
+ * @brief Provides a pointer to the next contiguous block of space in the write
+ * buffer.
+ * @param pointer Pointer.
+ * @param numberOfBytes Number of bytes.
+ * @param context Context.
+ */
+static void UsbWritePointer(void* * const pointer, size_t * const numberOfBytes, void* const context) {
+    UsbCdcWritePointer(pointer, numberOfBytes);
+}
+
+/**
+ * @brief Updates the write buffer after UsbWritePointer.
+ * @param numberOfBytes Number of bytes.
+ * @param context Context.
+ */
+static void UsbWritePointerComplete(const size_t numberOfBytes, void* const context) {
+    UsbCdcWritePointerComplete(numberOfBytes);
+}
+
+/**
+ * @brief Provides a pointer to the next contiguous block of data in the read
+ * buffer.
+ * @param pointer Pointer.
+ * @param numberOfBytes Number of bytes.
+ * @param context Context.
+ */
+static void UsbReadPointer(void* * const pointer, size_t * const numberOfBytes, void* const context) {
+    UsbCdcReadPointer(pointer, numberOfBytes);
+}
+
+/**
+ * @brief Updates the read buffer after UsbReadPointer.
+ * @param numberOfBytes Number of bytes.
+ * @param context Context.
+ */
+static void UsbReadPointerComplete(const size_t numberOfBytes, void* const context) {
+    UsbCdcReadPointerComplete(numberOfBytes);
+}
+
 /**
  * @brief Ping command.
  * @param value Value.
@@ -141,9 +311,7 @@ static void Note(const char* * const value, Ximu3CommandResponse * const respons
         .timestamp = TimestampGet(),
         .string = string,
     };
-    char message[256];
-    const int numberOfBytes = Ximu3DataNotificationAscii(message, sizeof (message), &data);
-    UsbCdcWrite(message, numberOfBytes);
+    UsbWriteData(EncodeNotification, &data);
     Ximu3CommandRespond(response);
 }
 
@@ -158,10 +326,266 @@ void Timestamp(const char* * const value, Ximu3CommandResponse * const response,
     if (Ximu3CommandParseNumberU64(value, response, &timestamp) != Ximu3ResultOk) {
         return;
     }
-    TimestampSet(timestamp);
+    TimestampSynchronise(timestamp);
     Ximu3CommandRespond(response);
 }
 
+/**
+ * @brief Timestamp sync command.
+ * @param value Value.
+ * @param response Response.
+ * @param context Context.
+ */
+static void TimestampSync(const char* * const value, Ximu3CommandResponse * const response, void* const context) {
+    if (Ximu3CommandParseNull(value, response) != Ximu3ResultOk) {
+        return;
+    }
+    snprintf(response->value, sizeof (response->value), "{\"skew\":%.3f,\"residual\":%" PRId64 "}", TimestampGetSkew(), TimestampGetResidual());
+    Ximu3CommandRespond(response);
+}
+
+/**
+ * @brief Output command. A policy string sets the data output policy. A null
+ * value leaves the policy unchanged. Responds with the policy and counters.
+ * @param value Value.
+ * @param response Response.
+ * @param context Context.
+ */
+static void Output(const char* * const value, Ximu3CommandResponse * const response, void* const context) {
+
+    // Set policy
+    JsonType type;
+    if ((JsonParseType(value, &type) == JsonResultOk) && (type == JsonTypeString)) {
+        char string[XIMU3_VALUE_SIZE];
+        if (Ximu3CommandParseString(value, response, string, sizeof (string), NULL) != Ximu3ResultOk) {
+            return;
+        }
+        DataOutputPolicy policy = 0;
+        while (strcmp(string, PolicyToString(policy)) != 0) {
+            if (++policy > DataOutputPolicyCoalesce) {
+                Ximu3CommandRespondError(response, "Unknown policy");
+                return;
+            }
+        }
+        usbOutput.policy = policy;
+    } else if (Ximu3CommandParseNull(value, response) != Ximu3ResultOk) {
+        return;
+    }
+    snprintf(response->value, sizeof (response->value), "{\"policy\":\"%s\",\"pending\":%u,\"dropped_messages\":%" PRIu32 ",\"dropped_bytes\":%" PRIu32 ",\"read_overflow\":%" PRIu32 "}",
+            PolicyToString(usbOutput.policy),
+            (unsigned int) usbOutput.pendingSize,
+            usbOutput.droppedMessages,
+            usbOutput.droppedBytes,
+            UsbCdcReadBufferOverflow());
+    Ximu3CommandRespond(response);
+}
+
+/**
+ * @brief Stats command. Times are in microseconds and stack sizes are in
+ * bytes.
+ * @param value Value.
+ * @param response Response.
+ * @param context Context.
+ */
+static void Stats(const char* * const value, Ximu3CommandResponse * const response, void* const context) {
+    if (Ximu3CommandParseNull(value, response) != Ximu3ResultOk) {
+        return;
+    }
+    const Statistics * const statistics = StatisticsGet();
+    size_t index = 0;
+    ResponseAppend(response, &index, "{\"loops_per_second\":%" PRIu32 ",\"max_loop\":%" PRIu32 ",\"stack_used\":%u,\"stack_size\":%u",
+            statistics->loopsPerSecond,
+            statistics->maximumLoopTicks / TIMER_TICKS_PER_MICROSECOND,
+            (unsigned int) statistics->stackUsed,
+            (unsigned int) statistics->stackSize);
+    for (StatisticsEvent event = 0; event < StatisticsEventNumberOfEvents; event++) {
+        const StatisticsLateness * const lateness = &statistics->lateness[event];
+        ResponseAppend(response, &index, ",\"%s\":{\"count\":%" PRIu32 ",\"mean_lateness\":%" PRIu32 ",\"max_lateness\":%" PRIu32 "}",
+                StatisticsEventToString(event),
+                lateness->count,
+                lateness->count == 0 ? 0 : (uint32_t) ((lateness->total / lateness->count) / TIMER_TICKS_PER_MICROSECOND),
+                lateness->maximum / TIMER_TICKS_PER_MICROSECOND);
+    }
+    ResponseAppend(response, &index, "}");
+    Ximu3CommandRespond(response);
+}
+
+/**
+ * @brief Stats reset command.
+ * @param value Value.
+ * @param response Response.
+ * @param context Context.
+ */
+static void StatsReset(const char* * const value, Ximu3CommandResponse * const response, void* const context) {
+    if (Ximu3CommandParseNull(value, response) != Ximu3ResultOk) {
+        return;
+    }
+    StatisticsReset();
+    Ximu3CommandRespond(response);
+}
+
+/**
+ * @brief Download command. Starts sending the samples in the log as
+ * temperature data messages with their original timestamps. A null value
+ * downloads all samples. A timestamp downloads only the samples after the
+ * timestamp. Responds with the number of samples that will be downloaded.
+ * Fewer samples are sent if samples are overwritten before they are sent.
+ * @param value Value.
+ * @param response Response.
+ * @param context Context.
+ */
+static void Download(const char* * const value, Ximu3CommandResponse * const response, void* const context) {
+    JsonType type;
+    uint64_t timestamp = 0;
+    const bool all = (JsonParseType(value, &type) == JsonResultOk) && (type == JsonTypeNull);
+    if (all) {
+        if (Ximu3CommandParseNull(value, response) != Ximu3ResultOk) {
+            return;
+        }
+    } else {
+        if (Ximu3CommandParseNumberU64(value, response, &timestamp) != Ximu3ResultOk) {
+            return;
+        }
+    }
+    SampleLogCursorInitialise(&downloadCursor);
+    downloadInProgress = true;
+    downloadAll = all;
+    downloadAfter = timestamp;
+    downloadCount = 0;
+    uint32_t numberOfSamples = SampleLogNumberOfSamples();
+    if (all == false) {
+        SampleLogCursor cursor = downloadCursor;
+        uint64_t sampleTimestamp;
+        int16_t raw;
+        numberOfSamples = 0;
+        while (SampleLogRead(&cursor, &sampleTimestamp, &raw)) {
+            if (sampleTimestamp > timestamp) {
+                numberOfSamples++;
+            }
+        }
+    }
+    snprintf(response->value, sizeof (response->value), "%" PRIu32, numberOfSamples);
+    Ximu3CommandRespond(response);
+}
+
+#ifdef PROFILE_ENABLED
+
+/**
+ * @brief Profile command. A null value responds with the region names. A
+ * region name responds with the region statistics in profile ticks.
+ * @param value Value.
+ * @param response Response.
+ * @param context Context.
+ */
+static void Profile(const char* * const value, Ximu3CommandResponse * const response, void* const context) {
+
+    // Region names
+    JsonType type;
+    if ((JsonParseType(value, &type) == JsonResultOk) && (type == JsonTypeNull)) {
+        if (Ximu3CommandParseNull(value, response) != Ximu3ResultOk) {
+            return;
+        }
+        size_t index = 0;
+        ResponseAppend(response, &index, "{\"ticks_per_second\":%u,\"regions\":[", (unsigned int) PROFILE_TICKS_PER_SECOND);
+        for (ProfileRegion region = 0; region < ProfileRegionNumberOfRegions; region++) {
+            ResponseAppend(response, &index, "%s\"%s\"", region == 0 ? "" : ",", ProfileRegionToString(region));
+        }
+        ResponseAppend(response, &index, "]}");
+        Ximu3CommandRespond(response);
+        return;
+    }
+
+    // Region statistics
+    char string[XIMU3_VALUE_SIZE];
+    if (Ximu3CommandParseString(value, response, string, sizeof (string), NULL) != Ximu3ResultOk) {
+        return;
+    }
+    ProfileRegion region = 0;
+    while (strcmp(string, ProfileRegionToString(region)) != 0) {
+        if (++region >= ProfileRegionNumberOfRegions) {
+            Ximu3CommandRespondError(response, "Unknown region");
+            return;
+        }
+    }
+    const ProfileStatistics * const statistics = ProfileGetStatistics(region);
+    size_t index = 0;
+    ResponseAppend(response, &index, "{\"count\":%" PRIu32 ",\"min\":%" PRIu32 ",\"mean\":%" PRIu32 ",\"max\":%" PRIu32 ",\"histogram\":[",
+            statistics->count,
+            statistics->minimum,
+            statistics->count == 0 ? 0 : (uint32_t) (statistics->total / statistics->count),
+            statistics->maximum);
+    for (int bin = 0; bin < PROFILE_HISTOGRAM_BINS; bin++) {
+        ResponseAppend(response, &index, "%s%" PRIu32, bin == 0 ? "" : ",", statistics->histogram[bin]);
+    }
+    ResponseAppend(response, &index, "]}");
+    Ximu3CommandRespond(response);
+}
+
+/**
+ * @brief Profile reset command.
+ * @param value Value.
+ * @param response Response.
+ * @param context Context.
+ */
+static void ProfileResetCommand(const char* * const value, Ximu3CommandResponse * const response, void* const context) {
+    if (Ximu3CommandParseNull(value, response) != Ximu3ResultOk) {
+        return;
+    }
+    ProfileReset();
+    Ximu3CommandRespond(response);
+}
+
+#endif
+
+/**
+ * @brief Write epilogue callback. Settings are applied as soon as they are
+ * written.
+ * @param index Index.
+ * @param context Context.
+ */
+static void WriteEpilogue(const Ximu3SettingsIndex index, void* const context) {
+    switch (index) {
+        case Ximu3SettingsIndexTemperatureRate:
+            ApplyTemperatureRate();
+            break;
+        case Ximu3SettingsIndexTemperatureMedianSize:
+        case Ximu3SettingsIndexTemperatureDecimation:
+        case Ximu3SettingsIndexTemperatureLowPassShift:
+            ApplyFilterSettings();
+            break;
+        default:
+            break;
+    }
+}
+
+/**
+ * @brief Reconfigures the thermometer for the temperature rate setting. The
+ * setting is overwritten with the nearest supported rate so that the actual
+ * rate is returned in the command response.
+ */
+static void ApplyTemperatureRate(void) {
+    const ThermometerSettings thermometerSettings = ThermometerSettingsFromRate(Ximu3SettingsGet(&settings)->temperatureRate);
+    ThermometerSetSettings(&thermometerSettings);
+    const float rate = ThermometerSettingsToRate(&thermometerSettings);
+    Ximu3SettingsSet(&settings, Ximu3SettingsIndexTemperatureRate, &rate, true);
+}
+
+/**
+ * @brief Sets the filter settings. Invalid settings are overwritten with the
+ * values used by the filter.
+ */
+static void ApplyFilterSettings(void) {
+    FilterSettings filterSettings = {
+        .medianSize = Ximu3SettingsGet(&settings)->temperatureMedianSize,
+        .decimation = Ximu3SettingsGet(&settings)->temperatureDecimation,
+        .lowPassShift = Ximu3SettingsGet(&settings)->temperatureLowPassShift,
+    };
+    FilterSetSettings(&filterSettings);
+    Ximu3SettingsSet(&settings, Ximu3SettingsIndexTemperatureMedianSize, &filterSettings.medianSize, true);
+    Ximu3SettingsSet(&settings, Ximu3SettingsIndexTemperatureDecimation, &filterSettings.decimation, true);
+    Ximu3SettingsSet(&settings, Ximu3SettingsIndexTemperatureLowPassShift, &filterSettings.lowPassShift, true);
+}
+
 /**
  * @brief Error callback.
  * @param error Error.
@@ -172,9 +596,256 @@ static void Error(const char* const error, void* const context) {
         .timestamp = TimerGetTicks64() / TIMER_TICKS_PER_MICROSECOND,
         .string = error,
     };
+    UsbWriteData(EncodeError, &data);
+}
+
+/**
+ * @brief Download tasks. Sends downloaded samples while there is space in the
+ * write buffer and no messages are pending so that live data messages are not
+ * dropped. A notification is sent when the download is complete.
+ */
+static void DownloadTasks(void) {
+    while (downloadInProgress && (usbOutput.pendingSize == 0) && (UsbCdcAvailableWrite() >= DOWNLOAD_SPACE)) {
+        Ximu3DataTemperatureFixed data;
+        if (SampleLogRead(&downloadCursor, &data.timestamp, &data.temperature) == false) {
+            downloadInProgress = false;
+            char string[64];
+            snprintf(string, sizeof (string), "Download complete. %" PRIu32 " samples.", downloadCount);
+            const Ximu3DataNotification notification = {
+                .timestamp = TimestampGet(),
+                .string = string,
+            };
+            UsbWriteData(EncodeNotification, &notification);
+            return;
+        }
+        if (downloadAll || (data.timestamp > downloadAfter)) {
+            UsbWriteData(EncodeTemperature, &data);
+            downloadCount++;
+        }
+    }
+}
+
+/**
+ * @brief Writes a data message to the USB output. The message is encoded
+ * directly into the write buffer if no messages are pending and there is
+ * enough contiguous space, otherwise the message is encoded into an
+ * intermediate buffer and written according to the output policy.
+ * @param encode Encoder.
+ * @param data Data.
+ */
+static void UsbWriteData(const DataEncode encode, const void* const data) {
+    void* destination = NULL;
+    size_t destinationSize = 0;
+    if (usbOutput.pendingSize == 0) {
+        UsbCdcWritePointer(&destination, &destinationSize);
+    }
+    const size_t numberOfBytes = encode(destination, destinationSize, data);
+    if (numberOfBytes < destinationSize) {
+        UsbCdcWritePointerComplete(numberOfBytes);
+        return;
+    }
     char message[256];
-    const int numberOfBytes = Ximu3DataErrorAscii(message, sizeof (message), &data);
-    UsbWrite(message, numberOfBytes, context);
+    const size_t messageSize = encode(message, sizeof (message), data);
+    if (messageSize < sizeof (message)) {
+        DataOutputWrite(&usbOutput, message, messageSize);
+    } else {
+        Drop(&usbOutput, messageSize);
+    }
+}
+
+/**
+ * @brief Encodes a notification message as binary or ASCII according to the
+ * binary mode setting.
+ * @param destination Destination.
+ * @param destinationSize Destination size.
+ * @param data Data.
+ * @return Message size.
+ */
+static size_t EncodeNotification(void* const destination, const size_t destinationSize, const void* const data) {
+    if (Ximu3SettingsGet(&settings)->binaryModeEnabled) {
+        return Ximu3DataNotificationBinary(destination, destinationSize, data);
+    }
+    return Ximu3DataNotificationAscii(destination, destinationSize, data);
+}
+
+/**
+ * @brief Encodes an error message as binary or ASCII according to the binary
+ * mode setting.
+ * @param destination Destination.
+ * @param destinationSize Destination size.
+ * @param data Data.
+ * @return Message size.
+ */
+static size_t EncodeError(void* const destination, const size_t destinationSize, const void* const data) {
+    if (Ximu3SettingsGet(&settings)->binaryModeEnabled) {
+        return Ximu3DataErrorBinary(destination, destinationSize, data);
+    }
+    return Ximu3DataErrorAscii(destination, destinationSize, data);
+}
+
+/**
+ * @brief Encodes a temperature message as binary or ASCII according to the
+ * binary mode setting.
+ * @param destination Destination.
+ * @param destinationSize Destination size.
+ * @param data Data.
+ * @return Message size.
+ */
+static size_t EncodeTemperature(void* const destination, const size_t destinationSize, const void* const data) {
+    if (Ximu3SettingsGet(&settings)->binaryModeEnabled) {
+        return Ximu3DataTemperatureFixedBinary(destination, destinationSize, data);
+    }
+    return Ximu3DataTemperatureFixedAscii(destination, destinationSize, data);
+}
+
+/**
+ * @brief Data output tasks. Writes as many whole pending messages as there
+ * is space for in the write buffer.
+ * @param output Data output.
+ */
+static void DataOutputTasks(DataOutput * const output) {
+    const size_t spaceAvailable = output->availableWrite();
+    size_t numberOfBytes = 0;
+    while (numberOfBytes < output->pendingSize) {
+        const size_t messageSize = MessageSize(&output->pending[numberOfBytes], output->pendingSize - numberOfBytes);
+        if ((numberOfBytes + messageSize) > spaceAvailable) {
+            break;
+        }
+        numberOfBytes += messageSize;
+    }
+    if ((numberOfBytes == 0) || (output->write(output->pending, numberOfBytes) != FifoResultOk)) {
+        return;
+    }
+    RemoveMessage(output, 0, numberOfBytes);
+}
+
+/**
+ * @brief Writes a message. If the message cannot be written then it is
+ * handled according to the output policy.
+ * @param output Data output.
+ * @param message Message.
+ * @param numberOfBytes Number of bytes.
+ */
+static void DataOutputWrite(DataOutput * const output, const char* const message, const size_t numberOfBytes) {
+
+    // Write message if no messages pending
+    if (output->pendingSize == 0) {
+        if (output->write(message, numberOfBytes) == FifoResultOk) {
+            return;
+        }
+    }
+
+    // Drop message if it cannot be pending
+    if ((output->policy == DataOutputPolicyDropNewest) || (numberOfBytes > sizeof (output->pending))) {
+        Drop(output, numberOfBytes);
+        return;
+    }
+
+    // Remove pending message of the same type
+    if (output->policy == DataOutputPolicyCoalesce) {
+        size_t index = 0;
+        while (index < output->pendingSize) {
+            const size_t messageSize = MessageSize(&output->pending[index], output->pendingSize - index);
+            if (output->pending[index] == message[0]) {
+                Drop(output, messageSize);
+                RemoveMessage(output, index, messageSize);
+                break;
+            }
+            index += messageSize;
+        }
+    }
+
+    // Remove oldest pending messages until there is space
+    while ((output->pendingSize + numberOfBytes) > sizeof (output->pending)) {
+        const size_t messageSize = MessageSize(output->pending, output->pendingSize);
+        Drop(output, messageSize);
+        RemoveMessage(output, 0, messageSize);
+    }
+
+    // Add message to pending messages
+    memcpy(&output->pending[output->pendingSize], message, numberOfBytes);
+    output->pendingSize += numberOfBytes;
+}
+
+/**
+ * @brief Returns the size of the first message including the newline
+ * character.
+ * @param messages Messages.
+ * @param numberOfBytes Number of bytes.
+ * @return Size of the first message.
+ */
+static size_t MessageSize(const char* const messages, const size_t numberOfBytes) {
+    const char* const newline = memchr(messages, '\n', numberOfBytes);
+    if (newline == NULL) {
+        return numberOfBytes;
+    }
+    return (newline - messages) + 1;
+}
+
+/**
+ * @brief Removes bytes from the pending messages.
+ * @param output Data output.
+ * @param index Index of the first byte.
+ * @param numberOfBytes Number of bytes.
+ */
+static void RemoveMessage(DataOutput * const output, const size_t index, const size_t numberOfBytes) {
+    memmove(&output->pending[index], &output->pending[index + numberOfBytes], output->pendingSize - index - numberOfBytes);
+    output->pendingSize -= numberOfBytes;
+}
+
+/**
+ * @brief Increments the dropped message counters.
+ * @param output Data output.
+ * @param numberOfBytes Number of bytes of the message.
+ */
+static void Drop(DataOutput * const output, const size_t numberOfBytes) {
+    output->droppedMessages++;
+    output->droppedBytes += numberOfBytes;
+}
+
+/**
+ * @brief Returns the data output policy string.
+ * @param policy Data output policy.
+ * @return Data output policy string.
+ */
+static const char* PolicyToString(const DataOutputPolicy policy) {
+    switch (policy) {
+        case DataOutputPolicyDropNewest:
+            return "drop_newest";
+        case DataOutputPolicyDropOldest:
+            return "drop_oldest";
+        case DataOutputPolicyCoalesce:
+            return "coalesce";
+    }
+    return ""; // avoid compiler warning
+}
+
+/**
+ * @brief Appends a formatted string to the response value. The index is
+ * limited to the index of the null terminator if the string is truncated so
+ * that the index never exceeds the value size and subsequent strings are
+ * discarded.
+ * @param response Response.
+ * @param index Index of the null terminator of the value.
+ * @param format Format.
+ * @param ... Arguments.
+ */
+static void ResponseAppend(Ximu3CommandResponse * const response, size_t * const index, const char* const format, ...) {
+    const size_t lastIndex = sizeof (response->value) - 1;
+    if (*index >= lastIndex) {
+        return;
+    }
+    va_list arguments;
+    va_start(arguments, format);
+    const int length = vsnprintf(&response->value[*index], sizeof (response->value) - *index, format, arguments);
+    va_end(arguments);
+    if (length < 0) {
+        return;
+    }
+    *index += (size_t) length;
+    if (*index > lastIndex) {
+        *index = lastIndex;
+    }
 }
 
 //------------------------------------------------------------------------------
@@ -7,10 +7,17 @@
 #ifndef XIMU3_DEVICE_H
 #define XIMU3_DEVICE_H
 
+//------------------------------------------------------------------------------
+// Includes
+
+#include "x-IMU3-Device/Ximu3.h"
+
 //------------------------------------------------------------------------------
 // Function declarations
 
+void Ximu3DeviceInitialise(void);
 void Ximu3DeviceTasks(void);
+void Ximu3DeviceSendTemperature(const Ximu3DataTemperatureFixed * const data);
 
 #endif
 
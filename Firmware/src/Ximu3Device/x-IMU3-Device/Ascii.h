@@ -0,0 +1,304 @@
+/**
+ * @file Ascii.h
+ * @author Seb Madgwick
+ * @brief ASCII data messages. Numbers are formatted without printf and are
+ * identical to the "%" PRIu64 and "%.4f" formats.
+ */
+
+#ifndef ASCII_H
+#define ASCII_H
+
+//------------------------------------------------------------------------------
+// Includes
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+//------------------------------------------------------------------------------
+// Definitions
+
+/**
+ * @brief Number of decimal digits per 32-bit chunk used when formatting
+ * integers. Formatting each chunk using 32-bit arithmetic avoids a 64-bit
+ * division per digit.
+ */
+#define ASCII_DIGITS_PER_CHUNK (9)
+
+/**
+ * @brief 10 to the power of ASCII_DIGITS_PER_CHUNK.
+ */
+#define ASCII_CHUNK (1000000000)
+
+/**
+ * @brief Number of decimal places of floats.
+ */
+#define ASCII_DECIMAL_PLACES (4)
+
+/**
+ * @brief 10 to the power of ASCII_DECIMAL_PLACES.
+ */
+#define ASCII_DECIMAL_SCALE (10000)
+
+//------------------------------------------------------------------------------
+// Inline functions
+
+/**
+ * @brief Writes a character. The destination index is incremented even if the
+ * destination is full so that the message size is returned as for snprintf.
+ * @param destination Destination.
+ * @param destinationIndex Destination index.
+ * @param character Character.
+ */
+static inline void AsciiCharacter(void* const destination, const size_t destinationSize, size_t * const destinationIndex, const char character) {
+    if (*destinationIndex < destinationSize) {
+        ((char*) destination)[*destinationIndex] = character;
+    }
+    (*destinationIndex)++;
+}
+
+/**
+ * @brief Writes a chunk of decimal digits.
+ * @param destination Destination.
+ * @param destinationIndex Destination index.
+ * @param chunk Chunk.
+ * @param numberOfDigits Number of digits with leading zeros. 0 for no leading
+ * zeros.
+ */
+static inline void AsciiChunk(void* const destination, const size_t destinationSize, size_t * const destinationIndex, uint32_t chunk, int numberOfDigits) {
+    char digits[ASCII_DIGITS_PER_CHUNK];
+    int index = 0;
+    do {
+        digits[index++] = '0' + (chunk % 10);
+        chunk /= 10;
+    } while ((chunk > 0) || (index < numberOfDigits));
+    while (index > 0) {
+        AsciiCharacter(destination, destinationSize, destinationIndex, digits[--index]);
+    }
+}
+
+/**
+ * @brief Writes an unsigned integer represented as 32-bit words. The words are
+ * modified.
+ * @param destination Destination.
+ * @param destinationIndex Destination index.
+ * @param words Words, least significant first.
+ * @param numberOfWords Number of words.
+ */
+static inline void AsciiWords(void* const destination, const size_t destinationSize, size_t * const destinationIndex, uint32_t * const words, int numberOfWords) {
+
+    // Divide into chunks
+    uint32_t chunks[5]; // enough for 128 bits
+    int numberOfChunks = 0;
+    do {
+        uint32_t remainder = 0;
+        for (int index = numberOfWords - 1; index >= 0; index--) {
+            const uint64_t dividend = ((uint64_t) remainder << 32) | words[index];
+            words[index] = (uint32_t) (dividend / ASCII_CHUNK);
+            remainder = (uint32_t) (dividend % ASCII_CHUNK);
+        }
+        chunks[numberOfChunks++] = remainder;
+        while ((numberOfWords > 0) && (words[numberOfWords - 1] == 0)) {
+            numberOfWords--;
+        }
+    } while (numberOfWords > 0);
+
+    // Write chunks
+    AsciiChunk(destination, destinationSize, destinationIndex, chunks[--numberOfChunks], 0);
+    while (numberOfChunks > 0) {
+        AsciiChunk(destination, destinationSize, destinationIndex, chunks[--numberOfChunks], ASCII_DIGITS_PER_CHUNK);
+    }
+}
+
+/**
+ * @brief Writes an unsigned integer.
+ * @param destination Destination.
+ * @param destinationIndex Destination index.
+ * @param value Value.
+ */
+static inline void AsciiUnsigned(void* const destination, const size_t destinationSize, size_t * const destinationIndex, const uint64_t value) {
+    if (value < ASCII_CHUNK) {
+        AsciiChunk(destination, destinationSize, destinationIndex, (uint32_t) value, 0);
+        return;
+    }
+    uint32_t words[] = {(uint32_t) value, (uint32_t) (value >> 32)};
+    AsciiWords(destination, destinationSize, destinationIndex, words, 2);
+}
+
+/**
+ * @brief Writes the first character.
+ * @param destination Destination.
+ * @param destinationIndex Destination index.
+ * @param character First character.
+ */
+static inline void AsciiFirstCharacter(void* const destination, const size_t destinationSize, size_t * const destinationIndex, const char character) {
+    AsciiCharacter(destination, destinationSize, destinationIndex, character);
+}
+
+/**
+ * @brief Writes a comma followed by the timestamp.
+ * @param destination Destination.
+ * @param destinationIndex Destination index.
+ * @param timestamp Timestamp.
+ */
+static inline void AsciiTimestamp(void* const destination, const size_t destinationSize, size_t * const destinationIndex, const uint64_t timestamp) {
+    AsciiCharacter(destination, destinationSize, destinationIndex, ',');
+    AsciiUnsigned(destination, destinationSize, destinationIndex, timestamp);
+}
+
+/**
+ * @brief Writes a comma followed by a float with ASCII_DECIMAL_PLACES decimal
+ * places. The value is rounded to nearest with ties to even using the exact
+ * binary value so that the result is identical to "%.4f".
+ * @param destination Destination.
+ * @param destinationIndex Destination index.
+ * @param value Value.
+ */
+static inline void AsciiFloat(void* const destination, const size_t destinationSize, size_t * const destinationIndex, const float value_) {
+    AsciiCharacter(destination, destinationSize, destinationIndex, ',');
+
+    // Decompose value
+    uint32_t value;
+    memcpy(&value, &value_, sizeof (value));
+    const int biasedExponent = (value >> 23) & 0xFF;
+    uint32_t mantissa = value & 0x7FFFFF;
+    if ((value >> 31) != 0) {
+        AsciiCharacter(destination, destinationSize, destinationIndex, '-');
+    }
+
+    // NaN and infinity
+    if (biasedExponent == 0xFF) {
+        const char* string = mantissa == 0 ? "inf" : "nan";
+        while (*string != '\0') {
+            AsciiCharacter(destination, destinationSize, destinationIndex, *string++);
+        }
+        return;
+    }
+
+    // Value is mantissa * 2^exponent
+    int exponent;
+    if (biasedExponent == 0) {
+        exponent = 1 - 127 - 23; // subnormal
+    } else {
+        mantissa |= 0x800000;
+        exponent = biasedExponent - 127 - 23;
+    }
+
+    // Integer values
+    if (exponent >= 0) {
+        uint32_t words[4] = {0}; // enough for 128 bits
+        const int shift = exponent % 32;
+        words[exponent / 32] = mantissa << shift;
+        if ((shift > 0) && ((exponent / 32) < 3)) {
+            words[(exponent / 32) + 1] = mantissa >> (32 - shift);
+        }
+        AsciiWords(destination, destinationSize, destinationIndex, words, 4);
+        AsciiCharacter(destination, destinationSize, destinationIndex, '.');
+        AsciiChunk(destination, destinationSize, destinationIndex, 0, ASCII_DECIMAL_PLACES);
+        return;
+    }
+
+    // Scale and round to nearest, ties to even
+    uint64_t scaled = 0;
+    const int shift = -exponent;
+    if (shift < 64) {
+        const uint64_t product = (uint64_t) mantissa * ASCII_DECIMAL_SCALE; // exact
+        scaled = product >> shift;
+        const uint64_t remainder = product & ((1ULL << shift) - 1);
+        const uint64_t half = 1ULL << (shift - 1);
+        if ((remainder > half) || ((remainder == half) && ((scaled & 1) != 0))) {
+            scaled++;
+        }
+    }
+
+    // Write integer and fraction
+    uint32_t integer;
+    uint32_t fraction;
+    if (scaled <= UINT32_MAX) {
+        integer = (uint32_t) scaled / ASCII_DECIMAL_SCALE;
+        fraction = (uint32_t) scaled % ASCII_DECIMAL_SCALE;
+    } else {
+        integer = (uint32_t) (scaled / ASCII_DECIMAL_SCALE);
+        fraction = (uint32_t) (scaled % ASCII_DECIMAL_SCALE);
+    }
+    AsciiChunk(destination, destinationSize, destinationIndex, integer, 0);
+    AsciiCharacter(destination, destinationSize, destinationIndex, '.');
+    AsciiChunk(destination, destinationSize, destinationIndex, fraction, ASCII_DECIMAL_PLACES);
+}
+
+/**
+ * @brief Writes a comma followed by a fixed-point value with
+ * ASCII_DECIMAL_PLACES decimal places. The value is formatted without
+ * floating-point arithmetic and is identical to AsciiFloat of the value if the
+ * value has no more than 24 significant bits.
+ * @param destination Destination.
+ * @param destinationIndex Destination index.
+ * @param value Value in units of 2^-fractionBits.
+ * @param fractionBits Number of fractional bits. Must be 0 to 31.
+ */
+static inline void AsciiFixed(void* const destination, const size_t destinationSize, size_t * const destinationIndex, const int32_t value, const int fractionBits) {
+    AsciiCharacter(destination, destinationSize, destinationIndex, ',');
+    uint32_t magnitude = (uint32_t) value;
+    if (value < 0) {
+        AsciiCharacter(destination, destinationSize, destinationIndex, '-');
+        magnitude = -(uint32_t) value;
+    }
+
+    // Scale and round to nearest, ties to even
+    const uint64_t product = (uint64_t) magnitude * ASCII_DECIMAL_SCALE; // exact
+    uint64_t scaled = product >> fractionBits;
+    if (fractionBits > 0) {
+        const uint64_t remainder = product & ((1ULL << fractionBits) - 1);
+        const uint64_t half = 1ULL << (fractionBits - 1);
+        if ((remainder > half) || ((remainder == half) && ((scaled & 1) != 0))) {
+            scaled++;
+        }
+    }
+
+    // Write integer and fraction
+    uint32_t integer;
+    uint32_t fraction;
+    if (scaled <= UINT32_MAX) {
+        integer = (uint32_t) scaled / ASCII_DECIMAL_SCALE;
+        fraction = (uint32_t) scaled % ASCII_DECIMAL_SCALE;
+    } else {
+        integer = (uint32_t) (scaled / ASCII_DECIMAL_SCALE);
+        fraction = (uint32_t) (scaled % ASCII_DECIMAL_SCALE);
+    }
+    AsciiUnsigned(destination, destinationSize, destinationIndex, integer);
+    AsciiCharacter(destination, destinationSize, destinationIndex, '.');
+    AsciiChunk(destination, destinationSize, destinationIndex, fraction, ASCII_DECIMAL_PLACES);
+}
+
+/**
+ * @brief Writes a comma followed by a string.
+ * @param destination Destination.
+ * @param destinationIndex Destination index.
+ * @param string String.
+ */
+static inline void AsciiString(void* const destination, const size_t destinationSize, size_t * const destinationIndex, const char* string) {
+    AsciiCharacter(destination, destinationSize, destinationIndex, ',');
+    while (*string != '\0') {
+        AsciiCharacter(destination, destinationSize, destinationIndex, *string++);
+    }
+}
+
+/**
+ * @brief Writes the termination. The destination is null terminated as for
+ * snprintf.
+ * @param destination Destination.
+ * @param destinationIndex Destination index.
+ */
+static inline void AsciiTermination(void* const destination, const size_t destinationSize, size_t * const destinationIndex) {
+    AsciiCharacter(destination, destinationSize, destinationIndex, '\n');
+    if (*destinationIndex < destinationSize) {
+        ((char*) destination)[*destinationIndex] = '\0';
+    } else if (destinationSize > 0) {
+        ((char*) destination)[destinationSize - 1] = '\0';
+    }
+}
+
+#endif
+
+//------------------------------------------------------------------------------
+// End of file
@@ -10,6 +10,7 @@
 //------------------------------------------------------------------------------
 // Includes
 
+#include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
 #include <string.h>
@@ -37,6 +38,13 @@
  */
 #define BYTE_STUFFING_ESC_ESC 0xDD
 
+/**
+ * @brief Returns the maximum message size after byte stuffing, including the
+ * termination, for a number of bytes before byte stuffing. A message must only
+ * be written if the destination size is at least the maximum message size.
+ */
+#define BINARY_MAXIMUM_SIZE(numberOfBytes) ((2 * (numberOfBytes)) + 1)
+
 //------------------------------------------------------------------------------
 // Inline functions
 
@@ -46,33 +54,66 @@
  * @param destinationIndex Destination index.
  * @param byte Byte.
  */
-static inline void BinaryWrite(void* const destination, const size_t destinationSize, size_t * const destinationIndex, const uint8_t byte) {
-    if (*destinationIndex >= destinationSize) {
-        return;
-    }
+static inline __attribute__((always_inline)) void BinaryWrite(uint8_t * const destination, size_t * const destinationIndex, const uint8_t byte) {
     switch (byte) {
         case BYTE_STUFFING_END:
-            ((uint8_t*) destination)[(*destinationIndex)++] = BYTE_STUFFING_ESC;
-            ((uint8_t*) destination)[(*destinationIndex)++] = BYTE_STUFFING_ESC_END;
+            destination[(*destinationIndex)++] = BYTE_STUFFING_ESC;
+            destination[(*destinationIndex)++] = BYTE_STUFFING_ESC_END;
             break;
         case BYTE_STUFFING_ESC:
-            ((uint8_t*) destination)[(*destinationIndex)++] = BYTE_STUFFING_ESC;
-            ((uint8_t*) destination)[(*destinationIndex)++] = BYTE_STUFFING_ESC_ESC;
+            destination[(*destinationIndex)++] = BYTE_STUFFING_ESC;
+            destination[(*destinationIndex)++] = BYTE_STUFFING_ESC_ESC;
             break;
         default:
-            ((uint8_t*) destination)[(*destinationIndex)++] = byte;
+            destination[(*destinationIndex)++] = byte;
             break;
     }
 }
 
+/**
+ * @brief Returns true if any byte of the word requires byte stuffing. Each
+ * byte is compared to the end and escape bytes in parallel using the
+ * "has zero byte" test.
+ * @param word Word.
+ * @return True if any byte of the word requires byte stuffing.
+ */
+static inline __attribute__((always_inline)) bool BinaryRequiresStuffing(const uint32_t word) {
+    const uint32_t end = word ^ (0x01010101UL * BYTE_STUFFING_END);
+    const uint32_t esc = word ^ (0x01010101UL * BYTE_STUFFING_ESC);
+    return ((((end - 0x01010101UL) & ~end) | ((esc - 0x01010101UL) & ~esc)) & 0x80808080UL) != 0;
+}
+
+/**
+ * @brief Writes a 32-bit word, least significant byte first. The bytes are
+ * written without per-byte byte stuffing if no byte requires byte stuffing.
+ * @param destination Destination.
+ * @param destinationIndex Destination index.
+ * @param word Word.
+ */
+static inline __attribute__((always_inline)) void BinaryWord(uint8_t * const destination, size_t * const destinationIndex, const uint32_t word) {
+    if (BinaryRequiresStuffing(word)) {
+        BinaryWrite(destination, destinationIndex, (word >> 0) & 0xFF);
+        BinaryWrite(destination, destinationIndex, (word >> 8) & 0xFF);
+        BinaryWrite(destination, destinationIndex, (word >> 16) & 0xFF);
+        BinaryWrite(destination, destinationIndex, (word >> 24) & 0xFF);
+        return;
+    }
+    uint8_t * const bytes = &destination[*destinationIndex];
+    bytes[0] = (word >> 0) & 0xFF;
+    bytes[1] = (word >> 8) & 0xFF;
+    bytes[2] = (word >> 16) & 0xFF;
+    bytes[3] = (word >> 24) & 0xFF;
+    *destinationIndex += 4;
+}
+
 /**
  * @brief Writes the first byte.
  * @param destination Destination.
  * @param destinationIndex Destination index.
  * @param character First character of equivalent ASCII data message.
  */
-static inline void BinaryFirstByte(void* const destination, const size_t destinationSize, size_t * const destinationIndex, const char character) {
-    BinaryWrite(destination, destinationSize, destinationIndex, 0x80 + character);
+static inline void BinaryFirstByte(void* const destination, size_t * const destinationIndex, const char character) {
+    BinaryWrite(destination, destinationIndex, 0x80 + character);
 }
 
 /**
@@ -81,15 +122,9 @@ static inline void BinaryFirstByte(void* const destination, const size_t destina
  * @param destinationIndex Destination index.
  * @param timestamp Timestamp.
  */
-static inline void BinaryTimestamp(void* const destination, const size_t destinationSize, size_t * const destinationIndex, const uint64_t timestamp) {
-    BinaryWrite(destination, destinationSize, destinationIndex, (timestamp >> 0) & 0xFF);
-    BinaryWrite(destination, destinationSize, destinationIndex, (timestamp >> 8) & 0xFF);
-    BinaryWrite(destination, destinationSize, destinationIndex, (timestamp >> 16) & 0xFF);
-    BinaryWrite(destination, destinationSize, destinationIndex, (timestamp >> 24) & 0xFF);
-    BinaryWrite(destination, destinationSize, destinationIndex, (timestamp >> 32) & 0xFF);
-    BinaryWrite(destination, destinationSize, destinationIndex, (timestamp >> 40) & 0xFF);
-    BinaryWrite(destination, destinationSize, destinationIndex, (timestamp >> 48) & 0xFF);
-    BinaryWrite(destination, destinationSize, destinationIndex, (timestamp >> 56) & 0xFF);
+static inline void BinaryTimestamp(void* const destination, size_t * const destinationIndex, const uint64_t timestamp) {
+    BinaryWord(destination, destinationIndex, (uint32_t) timestamp);
+    BinaryWord(destination, destinationIndex, (uint32_t) (timestamp >> 32));
 }
 
 /**
@@ -98,13 +133,45 @@ static inline void BinaryTimestamp(void* const destination, const size_t destina
  * @param destinationIndex Destination index.
  * @param value Value.
  */
-static inline void BinaryFloat(void* const destination, const size_t destinationSize, size_t * const destinationIndex, const float value_) {
+static inline void BinaryFloat(void* const destination, size_t * const destinationIndex, const float value_) {
     uint32_t value;
     memcpy(&value, &value_, sizeof (value));
-    BinaryWrite(destination, destinationSize, destinationIndex, (value >> 0) & 0xFF);
-    BinaryWrite(destination, destinationSize, destinationIndex, (value >> 8) & 0xFF);
-    BinaryWrite(destination, destinationSize, destinationIndex, (value >> 16) & 0xFF);
-    BinaryWrite(destination, destinationSize, destinationIndex, (value >> 24) & 0xFF);
+    BinaryWord(destination, destinationIndex, value);
+}
+
+/**
+ * @brief Writes a fixed-point value as a float. The float is constructed from
+ * the integer without floating-point arithmetic and is identical to
+ * BinaryFloat of the value if the value has no more than 24 significant bits.
+ * Less significant bits are truncated. Subnormal floats are not supported and
+ * so the number of fractional bits is limited.
+ * @param destination Destination.
+ * @param destinationIndex Destination index.
+ * @param value Value in units of 2^-fractionBits.
+ * @param fractionBits Number of fractional bits. Must be 0 to 31.
+ */
+static inline void BinaryFixed(void* const destination, size_t * const destinationIndex, const int32_t value, const int fractionBits) {
+    uint32_t word = 0;
+    if (value != 0) {
+        const uint32_t magnitude = value < 0 ? -(uint32_t) value : (uint32_t) value;
+        const int msb = 31 - __builtin_clz(magnitude);
+        const uint32_t mantissa = msb > 23 ? magnitude >> (msb - 23) : magnitude << (23 - msb);
+        word = (value < 0 ? 0x80000000 : 0) | ((uint32_t) (msb - fractionBits + 127) << 23) | (mantissa & 0x7FFFFF);
+    }
+    BinaryWord(destination, destinationIndex, word);
+}
+
+/**
+ * @brief Writes bytes.
+ * @param destination Destination.
+ * @param destinationIndex Destination index.
+ * @param data Data.
+ * @param numberOfBytes Number of bytes.
+ */
+static inline void BinaryBytes(void* const destination, size_t * const destinationIndex, const uint8_t* const data, const size_t numberOfBytes) {
+    for (size_t index = 0; index < numberOfBytes; index++) {
+        BinaryWrite(destination, destinationIndex, data[index]);
+    }
 }
 
 /**
@@ -113,9 +180,9 @@ static inline void BinaryFloat(void* const destination, const size_t destination
  * @param destinationIndex Destination index.
  * @param string String.
  */
-static inline void BinaryString(void* const destination, const size_t destinationSize, size_t * const destinationIndex, const char* string) {
+static inline void BinaryString(void* const destination, size_t * const destinationIndex, const char* string) {
     while (*string != '\0') {
-        BinaryWrite(destination, destinationSize, destinationIndex, *string++);
+        BinaryWrite(destination, destinationIndex, *string++);
     }
 }
 
@@ -124,10 +191,7 @@ static inline void BinaryString(void* const destination, const size_t destinatio
  * @param destination Destination.
  * @param destinationIndex Destination index.
  */
-static inline void BinaryTermination(void* const destination, const size_t destinationSize, size_t * const destinationIndex) {
-    if (*destinationIndex >= destinationSize) {
-        return;
-    }
+static inline void BinaryTermination(void* const destination, size_t * const destinationIndex) {
     ((uint8_t*) destination)[(*destinationIndex)++] = BYTE_STUFFING_END;
 }
 
@@ -69,6 +69,47 @@ bool KeyStartsWith(const char* * const a, const char* b) {
     }
 }
 
+/**
+ * @brief Normalises a key by removing non-alphanumeric characters and
+ * converting to lower-case. Keys that match according to KeyMatches will have
+ * the same normalised key.
+ * @param destination Destination.
+ * @param destinationSize Destination size.
+ * @param key Key.
+ * @return False if the normalised key was truncated.
+ */
+bool KeyNormalise(char* const destination, const size_t destinationSize, const char* key) {
+    size_t index = 0;
+    while (true) {
+        SkipNonAlphanumeric(&key);
+        if (index >= destinationSize) {
+            destination[destinationSize - 1] = '\0';
+            return false;
+        }
+        destination[index++] = ToLower(*key);
+        if (*key == '\0') {
+            return true;
+        }
+        key++;
+    }
+}
+
+/**
+ * @brief Returns the 32-bit FNV-1a hash of a normalised key. The hash must
+ * match that used by generate.py.
+ * @param normalisedKey Normalised key.
+ * @param seed Seed used as the offset basis.
+ * @return Hash.
+ */
+uint32_t KeyHash(const char* normalisedKey, const uint32_t seed) {
+    uint32_t hash = seed;
+    while (*normalisedKey != '\0') {
+        hash ^= (uint8_t) *normalisedKey++;
+        hash *= 16777619;
+    }
+    return hash;
+}
+
 /**
  * @brief Advances the pointer to first alphanumeric character.
  * @param string String.
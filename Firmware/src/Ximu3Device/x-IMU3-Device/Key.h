@@ -11,12 +11,16 @@
 // Includes
 
 #include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
 
 //------------------------------------------------------------------------------
 // Function declarations
 
 bool KeyMatches(const char* a, const char* b);
 bool KeyStartsWith(const char* * const a, const char* b);
+bool KeyNormalise(char* const destination, const size_t destinationSize, const char* key);
+uint32_t KeyHash(const char* normalisedKey, const uint32_t seed);
 
 #endif
 
@@ -1,6 +1,12 @@
 // This file was generated by generate.py
 
+#include "Key.h"
 #include "Metadata.h"
+#include <string.h>
+
+#define HASH_SEED 0x811C9DC5
+
+#define HASH_BITS 4
 
 static const char* const names[] = {
     "Serial Number",
@@ -13,6 +19,10 @@ static const char* const names[] = {
     "Binary Mode Enabled",
     "USB Data Messages Enabled",
     "Serial Data Messages Enabled",
+    "Temperature Rate",
+    "Temperature Median Size",
+    "Temperature Decimation",
+    "Temperature Low-pass Shift",
     "Example Float",
 };
 
@@ -27,9 +37,69 @@ static const char* const keys[] = {
     "binary_mode_enabled",
     "usb_data_messages_enabled",
     "serial_data_messages_enabled",
+    "temperature_rate",
+    "temperature_median_size",
+    "temperature_decimation",
+    "temperature_low_pass_shift",
     "example_float",
 };
 
+static const char* const normalisedKeys[] = {
+    "serialnumber",
+    "hardwareversion",
+    "firmwareversion",
+    "devicename",
+    "serialenabled",
+    "serialbaudrate",
+    "serialrtsctsenabled",
+    "binarymodeenabled",
+    "usbdatamessagesenabled",
+    "serialdatamessagesenabled",
+    "temperaturerate",
+    "temperaturemediansize",
+    "temperaturedecimation",
+    "temperaturelowpassshift",
+    "examplefloat",
+};
+
+static const uint32_t hashDisplacements[1 << HASH_BITS] = {
+    0,
+    0,
+    0,
+    0,
+    0,
+    2,
+    0,
+    2,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    1,
+};
+
+static const int hashTable[1 << HASH_BITS] = {
+    Ximu3SettingsIndexHardwareVersion,
+    Ximu3SettingsIndexSerialRtsCtsEnabled,
+    Ximu3SettingsIndexDeviceName,
+    -1,
+    Ximu3SettingsIndexFirmwareVersion,
+    Ximu3SettingsIndexTemperatureMedianSize,
+    Ximu3SettingsIndexSerialNumber,
+    Ximu3SettingsIndexTemperatureDecimation,
+    Ximu3SettingsIndexTemperatureRate,
+    Ximu3SettingsIndexSerialDataMessagesEnabled,
+    Ximu3SettingsIndexUsbDataMessagesEnabled,
+    Ximu3SettingsIndexBinaryModeEnabled,
+    Ximu3SettingsIndexExampleFloat,
+    Ximu3SettingsIndexSerialBaudRate,
+    Ximu3SettingsIndexTemperatureLowPassShift,
+    Ximu3SettingsIndexSerialEnabled,
+};
+
 const MetadataType types[] = {
     MetadataTypeString,
     MetadataTypeString,
@@ -42,6 +112,10 @@ const MetadataType types[] = {
     MetadataTypeBool,
     MetadataTypeBool,
     MetadataTypeFloat,
+    MetadataTypeUint32,
+    MetadataTypeUint32,
+    MetadataTypeUint32,
+    MetadataTypeFloat,
 };
 
 const size_t sizes[] = {
@@ -55,6 +129,10 @@ const size_t sizes[] = {
     sizeof (((Ximu3SettingsValues *) 0)->binaryModeEnabled),
     sizeof (((Ximu3SettingsValues *) 0)->usbDataMessagesEnabled),
     sizeof (((Ximu3SettingsValues *) 0)->serialDataMessagesEnabled),
+    sizeof (((Ximu3SettingsValues *) 0)->temperatureRate),
+    sizeof (((Ximu3SettingsValues *) 0)->temperatureMedianSize),
+    sizeof (((Ximu3SettingsValues *) 0)->temperatureDecimation),
+    sizeof (((Ximu3SettingsValues *) 0)->temperatureLowPassShift),
     sizeof (((Ximu3SettingsValues *) 0)->exampleFloat),
 };
 
@@ -70,6 +148,10 @@ const void* const defaults[] = {
     (void*) (&(bool) {true}),
     (void*) (&(bool) {true}),
     (void*) (&(float) {1.0f}),
+    (void*) (&(uint32_t) {1}),
+    (void*) (&(uint32_t) {1}),
+    (void*) (&(uint32_t) {0}),
+    (void*) (&(float) {1.0f}),
 };
 
 const bool preserveds[] = {
@@ -84,6 +166,10 @@ const bool preserveds[] = {
     false,
     false,
     false,
+    false,
+    false,
+    false,
+    false,
 };
 
 const bool readOnlys[] = {
@@ -98,6 +184,10 @@ const bool readOnlys[] = {
     false,
     false,
     false,
+    false,
+    false,
+    false,
+    false,
 };
 
 static void* GetValue(Ximu3Settings * const settings, const Ximu3SettingsIndex index) {
@@ -122,6 +212,14 @@ static void* GetValue(Ximu3Settings * const settings, const Ximu3SettingsIndex i
             return &settings->values.usbDataMessagesEnabled;
         case Ximu3SettingsIndexSerialDataMessagesEnabled:
             return &settings->values.serialDataMessagesEnabled;
+        case Ximu3SettingsIndexTemperatureRate:
+            return &settings->values.temperatureRate;
+        case Ximu3SettingsIndexTemperatureMedianSize:
+            return &settings->values.temperatureMedianSize;
+        case Ximu3SettingsIndexTemperatureDecimation:
+            return &settings->values.temperatureDecimation;
+        case Ximu3SettingsIndexTemperatureLowPassShift:
+            return &settings->values.temperatureLowPassShift;
         case Ximu3SettingsIndexExampleFloat:
             return &settings->values.exampleFloat;
 
@@ -143,3 +241,18 @@ Metadata MetadataGet(Ximu3Settings * const settings, const Ximu3SettingsIndex in
     };
     return metadata;
 }
+
+Ximu3Result MetadataGetIndex(Ximu3SettingsIndex * const index, const char* const key) {
+    char normalisedKey[XIMU3_KEY_SIZE];
+    if (KeyNormalise(normalisedKey, sizeof (normalisedKey), key) == false) {
+        return Ximu3ResultError;
+    }
+    const uint32_t hash = KeyHash(normalisedKey, HASH_SEED);
+    const uint32_t displacement = hashDisplacements[hash >> (32 - HASH_BITS)];
+    const int hashTableIndex = hashTable[((hash ^ displacement) * 0x9E3779B1) >> (32 - HASH_BITS)];
+    if ((hashTableIndex < 0) || (strcmp(normalisedKey, normalisedKeys[hashTableIndex]) != 0)) {
+        return Ximu3ResultError;
+    }
+    *index = hashTableIndex;
+    return Ximu3ResultOk;
+}
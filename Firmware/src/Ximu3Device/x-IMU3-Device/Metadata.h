@@ -30,4 +30,6 @@ typedef struct {
 
 Metadata MetadataGet(Ximu3Settings * const settings, const Ximu3SettingsIndex index);
 
+Ximu3Result MetadataGetIndex(Ximu3SettingsIndex * const index, const char* const key);
+
 #endif
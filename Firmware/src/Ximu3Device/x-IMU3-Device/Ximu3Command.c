@@ -30,9 +30,10 @@
 // Function declarations
 
 static void Receive(Ximu3CommandBridge * const bridge, Ximu3CommandInterface * const interface);
-static void ParseMessage(const Ximu3CommandBridge * const bridge, const Ximu3CommandInterface * const interface, uint8_t * const message, const size_t messageSize);
+static void ReceiveInPlace(Ximu3CommandBridge * const bridge, Ximu3CommandInterface * const interface, uint8_t * const data, const size_t numberOfBytes);
+static void ParseMessage(Ximu3CommandBridge * const bridge, const Ximu3CommandInterface * const interface, uint8_t * const message, const size_t messageSize);
 static void ParseMux(const Ximu3CommandBridge * const bridge, const Ximu3CommandInterface * const interface, const uint8_t * const message, const size_t messageSize);
-static void ParseCommand(const Ximu3CommandBridge * const bridge, const Ximu3CommandInterface * const interface, uint8_t * const message, const size_t messageSize);
+static void ParseCommand(Ximu3CommandBridge * const bridge, const Ximu3CommandInterface * const interface, uint8_t * const message, const size_t messageSize);
 static void Error(const Ximu3CommandBridge * const bridge, const char* format, ...);
 
 //------------------------------------------------------------------------------
@@ -50,38 +51,105 @@ void Ximu3CommandTasks(Ximu3CommandBridge * const bridge) {
 }
 
 /**
- * @brief Receive data using the interface read callback.
+ * @brief Receive data using the interface read callbacks. Data is parsed in
+ * place if the interface provides a read pointer, otherwise data is read
+ * directly into the interface buffer.
  * @param bridge Bridge.
  * @param interface Interface.
  */
 static void Receive(Ximu3CommandBridge * const bridge, Ximu3CommandInterface * const interface) {
-    while (true) {
 
-        // Read data
-        uint8_t data[XIMU3_READ_SIZE];
-        const size_t numberOfBytes = interface->read(data, sizeof (data), bridge->context);
+    // Read in place
+    if (interface->readPointer != NULL) {
+        while (true) {
+            uint8_t* data;
+            size_t numberOfBytes;
+            interface->readPointer((void**) &data, &numberOfBytes, bridge->context);
+            if (numberOfBytes == 0) {
+                break;
+            }
+            ReceiveInPlace(bridge, interface, data, numberOfBytes);
+            interface->readPointerComplete(numberOfBytes, bridge->context);
+        }
+        return;
+    }
+
+    // Read into buffer
+    while (true) {
+        size_t index = interface->index;
+        const size_t numberOfBytes = interface->read(&interface->buffer[index], sizeof (interface->buffer) - index, bridge->context);
         if (numberOfBytes == 0) {
             break;
         }
+        interface->index += numberOfBytes;
+
+        // Parse each complete message
+        size_t messageStart = 0;
+        while (true) {
+            const uint8_t * const termination = memchr(&interface->buffer[index], '\n', interface->index - index);
+            if (termination == NULL) {
+                break;
+            }
+            index = (size_t) (termination - interface->buffer) + 1;
+            ParseMessage(bridge, interface, &interface->buffer[messageStart], index - messageStart);
+            messageStart = index;
+        }
 
-        // Process each byte
-        for (size_t index = 0; index < numberOfBytes; index++) {
+        // Move incomplete message to start of buffer
+        interface->index -= messageStart;
+        memmove(interface->buffer, &interface->buffer[messageStart], interface->index);
 
-            // Add to buffer
-            interface->buffer[interface->index] = data[index];
+        // Discard buffer if full
+        if (interface->index >= sizeof (interface->buffer)) {
+            Error(bridge, "%s receive error. Buffer overrun.", interface->name);
+            interface->index = 0;
+        }
+    }
+}
 
-            // Parse if termination detected
-            if (interface->buffer[interface->index] == '\n') {
-                ParseMessage(bridge, interface, interface->buffer, interface->index + 1);
-                interface->index = 0;
-                continue;
-            }
+/**
+ * @brief Receive data provided by the interface read pointer. Complete
+ * messages are parsed in place if no data is buffered, otherwise data is added
+ * to the interface buffer.
+ * @param bridge Bridge.
+ * @param interface Interface.
+ * @param data Data.
+ * @param numberOfBytes Number of bytes.
+ */
+static void ReceiveInPlace(Ximu3CommandBridge * const bridge, Ximu3CommandInterface * const interface, uint8_t * const data, const size_t numberOfBytes) {
+
+    // Process each run of bytes up to and including the termination
+    size_t index = 0;
+    while (index < numberOfBytes) {
+        uint8_t * const run = &data[index];
+        const uint8_t * const termination = memchr(run, '\n', numberOfBytes - index);
+        const size_t runSize = termination == NULL ? (numberOfBytes - index) : (size_t) (termination - run) + 1;
+
+        // Parse in place if the run is a complete message
+        if ((termination != NULL) && (interface->index == 0) && (runSize <= sizeof (interface->buffer))) {
+            ParseMessage(bridge, interface, run, runSize);
+            index += runSize;
+            continue;
+        }
 
-            // Increment index
-            if (++interface->index >= sizeof (interface->buffer)) {
-                Error(bridge, "%s receive error. Buffer overrun.", interface->name);
-                interface->index = 0;
-            }
+        // Add to buffer
+        const size_t spaceAvailable = sizeof (interface->buffer) - interface->index;
+        const size_t numberOfBytesToCopy = runSize < spaceAvailable ? runSize : spaceAvailable;
+        memcpy(&interface->buffer[interface->index], run, numberOfBytesToCopy);
+        interface->index += numberOfBytesToCopy;
+        index += numberOfBytesToCopy;
+
+        // Parse if termination copied
+        if ((termination != NULL) && (numberOfBytesToCopy == runSize)) {
+            ParseMessage(bridge, interface, interface->buffer, interface->index);
+            interface->index = 0;
+            continue;
+        }
+
+        // Discard buffer if full
+        if (interface->index >= sizeof (interface->buffer)) {
+            Error(bridge, "%s receive error. Buffer overrun.", interface->name);
+            interface->index = 0;
         }
     }
 }
@@ -93,22 +161,20 @@ static void Receive(Ximu3CommandBridge * const bridge, Ximu3CommandInterface * c
  * @param data Data.
  * @param numberOfBytes Number of bytes.
  */
-void Ximu3CommandReceive(const Ximu3CommandBridge * const bridge, const Ximu3CommandInterface * const interface, const void* const data, const size_t numberOfBytes) {
+void Ximu3CommandReceive(Ximu3CommandBridge * const bridge, const Ximu3CommandInterface * const interface, const void* const data, const size_t numberOfBytes) {
 
     // Copy data
-    uint8_t message[XIMU3_OBJECT_SIZE];
-    if (numberOfBytes > sizeof (message)) {
+    uint8_t * const message = bridge->scratch.message;
+    if (numberOfBytes > sizeof (bridge->scratch.message)) {
         Error(bridge, "%s receive error. Buffer overrun.", interface->name);
         return;
     }
     memcpy(message, data, numberOfBytes);
 
     // Validate termination
-    for (size_t index = 0; index < (numberOfBytes - 1); index++) {
-        if (message[index] == '\n') {
-            Error(bridge, "%s receive error. Unexpected termination.", interface->name);
-            return;
-        }
+    if (memchr(message, '\n', numberOfBytes - 1) != NULL) {
+        Error(bridge, "%s receive error. Unexpected termination.", interface->name);
+        return;
     }
     if (message[numberOfBytes - 1] != '\n') {
         Error(bridge, "%s receive error. Missing termination.", interface->name);
@@ -126,7 +192,7 @@ void Ximu3CommandReceive(const Ximu3CommandBridge * const bridge, const Ximu3Com
  * @param message Message.
  * @param messageSize Message size.
  */
-static void ParseMessage(const Ximu3CommandBridge * const bridge, const Ximu3CommandInterface * const interface, uint8_t * const message, const size_t messageSize) {
+static void ParseMessage(Ximu3CommandBridge * const bridge, const Ximu3CommandInterface * const interface, uint8_t * const message, const size_t messageSize) {
     if (message[0] == '^') {
         ParseMux(bridge, interface, message, messageSize);
     } else {
@@ -167,7 +233,7 @@ static void ParseMux(const Ximu3CommandBridge * const bridge, const Ximu3Command
  * @param message Message.
  * @param messageSize Message size.
  */
-static void ParseCommand(const Ximu3CommandBridge * const bridge, const Ximu3CommandInterface * const interface, uint8_t * const message, const size_t messageSize) {
+static void ParseCommand(Ximu3CommandBridge * const bridge, const Ximu3CommandInterface * const interface, uint8_t * const message, const size_t messageSize) {
 
     // Terminate string
     message[messageSize - 1] = '\0';
@@ -187,8 +253,9 @@ static void ParseCommand(const Ximu3CommandBridge * const bridge, const Ximu3Com
     }
 
     // Parse key
-    char key[XIMU3_KEY_SIZE];
-    result = JsonParseKey(json, key, sizeof (key));
+    Ximu3CommandResponse * const response = &bridge->scratch.response;
+    const char* const key = response->key;
+    result = JsonParseKey(json, response->key, sizeof (response->key));
     if (result != JsonResultOk) {
         Error(bridge, "%s receive error. Unable to parse key. %s.", interface->name, JsonResultToString(result));
         return;
@@ -210,13 +277,14 @@ static void ParseCommand(const Ximu3CommandBridge * const bridge, const Ximu3Com
     }
 
     // Initialise response
-    Ximu3CommandResponse response = {.interface = interface, .value = "null", .context = bridge->context};
-    snprintf(response.key, sizeof (response.key), "%s", key);
+    response->interface = interface;
+    snprintf(response->value, sizeof (response->value), "null");
+    response->context = bridge->context;
 
     // Commands
     for (int index = 0; index < bridge->numberOfCommands; index++) {
         if (KeyMatches(key, bridge->commands[index].key)) {
-            bridge->commands[index].callback(&value, &response, bridge->context);
+            bridge->commands[index].callback(&value, response, bridge->context);
             return;
         }
     }
@@ -228,8 +296,8 @@ static void ParseCommand(const Ximu3CommandBridge * const bridge, const Ximu3Com
 
             // Read
             if (JsonParseNull(&value) == JsonResultOk) {
-                Ximu3SettingsJsonGetValue(bridge->settings, response.value, sizeof (response.value), index);
-                Ximu3CommandRespond(&response);
+                Ximu3SettingsJsonGetValue(bridge->settings, response->value, sizeof (response->value), index);
+                Ximu3CommandRespond(response);
                 return;
             }
 
@@ -237,19 +305,19 @@ static void ParseCommand(const Ximu3CommandBridge * const bridge, const Ximu3Com
             const Metadata metadata = MetadataGet(bridge->settings, index);
             const bool overrideReadOnly = bridge->overrideReadOnly == NULL ? false : bridge->overrideReadOnly(bridge->context);
             if (metadata.readOnly && (overrideReadOnly == false)) {
-                Ximu3CommandRespondError(&response, "Read-only");
+                Ximu3CommandRespondError(response, "Read-only");
                 return;
             }
             result = Ximu3SettingsJsonSetKeyValue(bridge->settings, key, &value, overrideReadOnly);
             if (result != JsonResultOk) {
-                Ximu3CommandRespondError(&response, JsonResultToString(result));
+                Ximu3CommandRespondError(response, JsonResultToString(result));
                 return;
             }
             if (bridge->writeEpilogue != NULL) {
                 bridge->writeEpilogue(index, bridge->context);
             }
-            Ximu3SettingsJsonGetValue(bridge->settings, response.value, sizeof (response.value), index);
-            Ximu3CommandRespond(&response);
+            Ximu3SettingsJsonGetValue(bridge->settings, response->value, sizeof (response->value), index);
+            Ximu3CommandRespond(response);
             return;
         }
 
@@ -258,23 +326,23 @@ static void ParseCommand(const Ximu3CommandBridge * const bridge, const Ximu3Com
         if (KeyStartsWith(&keyPointer, "enumerate")) {
             int integer;
             if (sscanf(keyPointer, "%i", &integer) != 1) {
-                Ximu3CommandRespondError(&response, "Unable to parse index");
+                Ximu3CommandRespondError(response, "Unable to parse index");
                 return;
             }
             if (Ximu3SettingsIndexFrom(&index, integer) == Ximu3ResultOk) {
-                Ximu3SettingsJsonGetObject(bridge->settings, response.value, sizeof (response.value), index);
+                Ximu3SettingsJsonGetObject(bridge->settings, response->value, sizeof (response->value), index);
             }
-            Ximu3CommandRespond(&response);
+            Ximu3CommandRespond(response);
             return;
         }
     }
 
     // Unknown command
     if (bridge->unknown != NULL) {
-        bridge->unknown(key, &value, &response, bridge->context);
+        bridge->unknown(key, &value, response, bridge->context);
         return;
     }
-    Ximu3CommandRespondError(&response, "Unknown command");
+    Ximu3CommandRespondError(response, "Unknown command");
 }
 
 /**
@@ -370,15 +438,36 @@ Ximu3Result Ximu3CommandParseNull(const char* * const value, Ximu3CommandRespons
 }
 
 /**
- * @brief Responds to command.
+ * @brief Responds to command. The response is written directly to the
+ * interface if the interface provides a write pointer with enough contiguous
+ * space, otherwise the response is copied from an intermediate buffer.
  * @param response Response.
  */
 void Ximu3CommandRespond(Ximu3CommandResponse * const response) {
-    char string[XIMU3_OBJECT_SIZE];
-    snprintf(string, sizeof (string), "{\"%s\":%s}\n", response->key, response->value);
-    response->interface->write(string, strlen(string), response->context);
+
+    // Write directly to interface
+    if (response->interface->writePointer != NULL) {
+        char* string;
+        size_t stringSize;
+        response->interface->writePointer((void**) &string, &stringSize, response->context);
+        if (stringSize > XIMU3_OBJECT_SIZE) {
+            stringSize = XIMU3_OBJECT_SIZE;
+        }
+        const int numberOfBytes = snprintf(string, stringSize, "{\"%s\":%s}\n", response->key, response->value);
+        if ((numberOfBytes >= 0) && ((size_t) numberOfBytes < stringSize)) {
+            response->interface->writePointerComplete(numberOfBytes, response->context);
+#ifdef PRINT_MESSAGES
+            printf("%s TX %s", response->interface->name, string);
+#endif
+            return;
+        }
+    }
+
+    // Write via intermediate buffer
+    snprintf(response->buffer, sizeof (response->buffer), "{\"%s\":%s}\n", response->key, response->value);
+    response->interface->write(response->buffer, strlen(response->buffer), response->context);
 #ifdef PRINT_MESSAGES
-    printf("%s TX %s", response->interface->name, string);
+    printf("%s TX %s", response->interface->name, response->buffer);
 #endif
 }
 
@@ -26,6 +26,10 @@ typedef struct {
     const char* const name;
     size_t(*const read)(void* const destination, size_t numberOfBytes, void* const context);
     void (*const write) (const void* const data, const size_t numberOfBytes, void* const context);
+    void (*const writePointer) (void* * const pointer, size_t * const numberOfBytes, void* const context); // NULL if unused
+    void (*const writePointerComplete) (const size_t numberOfBytes, void* const context); // NULL if unused
+    void (*const readPointer) (void* * const pointer, size_t * const numberOfBytes, void* const context); // NULL if unused
+    void (*const readPointerComplete) (const size_t numberOfBytes, void* const context); // NULL if unused
     uint8_t buffer[XIMU3_OBJECT_SIZE]; // private
     size_t index; // private
 } Ximu3CommandInterface;
@@ -38,8 +42,18 @@ typedef struct {
     char key[XIMU3_KEY_SIZE];
     char value[XIMU3_VALUE_SIZE];
     void* context;
+    char buffer[XIMU3_OBJECT_SIZE]; // private
 } Ximu3CommandResponse;
 
+/**
+ * @brief Scratch. Buffers used to parse and respond to a message. These are
+ * part of the bridge so that they are not allocated on the stack.
+ */
+typedef struct {
+    Ximu3CommandResponse response;
+    uint8_t message[XIMU3_OBJECT_SIZE];
+} Ximu3CommandScratch;
+
 /**
  * @brief Map.
  */
@@ -63,13 +77,14 @@ typedef struct {
     Ximu3Result(*const mux)(const Ximu3CommandInterface * const interface, const uint8_t channel, const void* const message, const size_t messageSize); // NULL if unused
     void (*const error) (const char* const error, void* const context); // NULL if unused
     void* context;
+    Ximu3CommandScratch scratch; // private
 } Ximu3CommandBridge;
 
 //------------------------------------------------------------------------------
 // Function declarations
 
 void Ximu3CommandTasks(Ximu3CommandBridge * const bridge);
-void Ximu3CommandReceive(const Ximu3CommandBridge * const bridge, const Ximu3CommandInterface * const interface, const void* const data, const size_t numberOfBytes);
+void Ximu3CommandReceive(Ximu3CommandBridge * const bridge, const Ximu3CommandInterface * const interface, const void* const data, const size_t numberOfBytes);
 Ximu3Result Ximu3CommandParseString(const char* * const value, Ximu3CommandResponse * const response, char* const destination, const size_t destinationSize, size_t * const numberOfBytes);
 Ximu3Result Ximu3CommandParseNumber(const char* * const value, Ximu3CommandResponse * const response, float* const number);
 Ximu3Result Ximu3CommandParseNumberU64(const char* * const value, Ximu3CommandResponse * const response, uint64_t * const number);
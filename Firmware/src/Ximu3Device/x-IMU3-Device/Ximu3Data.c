@@ -7,20 +7,12 @@
 //------------------------------------------------------------------------------
 // Includes
 
+#include "Ascii.h"
 #include "Binary.h"
 #include <ctype.h>
-#include <inttypes.h>
-#include <stdio.h>
+#include <string.h>
 #include "Ximu3Data.h"
 
-//------------------------------------------------------------------------------
-// Definitions
-
-/**
- * @brief Float format used by ASCII data messages.
- */
-#define FLOAT_FORMAT "%.4f"
-
 //------------------------------------------------------------------------------
 // Functions
 
@@ -32,16 +24,20 @@
  * @return Message size.
  */
 size_t Ximu3DataInertialBinary(void* const destination, const size_t destinationSize, const Ximu3DataInertial * const data) {
+    const size_t maximumSize = BINARY_MAXIMUM_SIZE(1 + 8 + (6 * 4));
+    if (destinationSize < maximumSize) {
+        return maximumSize;
+    }
     size_t destinationIndex = 0;
-    BinaryFirstByte(destination, destinationSize, &destinationIndex, 'I');
-    BinaryTimestamp(destination, destinationSize, &destinationIndex, data->timestamp);
-    BinaryFloat(destination, destinationSize, &destinationIndex, data->gyroscopeX);
-    BinaryFloat(destination, destinationSize, &destinationIndex, data->gyroscopeY);
-    BinaryFloat(destination, destinationSize, &destinationIndex, data->gyroscopeZ);
-    BinaryFloat(destination, destinationSize, &destinationIndex, data->accelerometerX);
-    BinaryFloat(destination, destinationSize, &destinationIndex, data->accelerometerY);
-    BinaryFloat(destination, destinationSize, &destinationIndex, data->accelerometerZ);
-    BinaryTermination(destination, destinationSize, &destinationIndex);
+    BinaryFirstByte(destination, &destinationIndex, 'I');
+    BinaryTimestamp(destination, &destinationIndex, data->timestamp);
+    BinaryFloat(destination, &destinationIndex, data->gyroscopeX);
+    BinaryFloat(destination, &destinationIndex, data->gyroscopeY);
+    BinaryFloat(destination, &destinationIndex, data->gyroscopeZ);
+    BinaryFloat(destination, &destinationIndex, data->accelerometerX);
+    BinaryFloat(destination, &destinationIndex, data->accelerometerY);
+    BinaryFloat(destination, &destinationIndex, data->accelerometerZ);
+    BinaryTermination(destination, &destinationIndex);
     return destinationIndex;
 }
 
@@ -53,16 +49,17 @@ size_t Ximu3DataInertialBinary(void* const destination, const size_t destination
  * @return Message size.
  */
 size_t Ximu3DataInertialAscii(void* const destination, const size_t destinationSize, const Ximu3DataInertial * const data) {
-    return snprintf(destination, destinationSize, "I,%" PRIu64 ","
-            FLOAT_FORMAT "," FLOAT_FORMAT "," FLOAT_FORMAT ","
-            FLOAT_FORMAT "," FLOAT_FORMAT "," FLOAT_FORMAT "\n",
-            data->timestamp,
-            data->gyroscopeX,
-            data->gyroscopeY,
-            data->gyroscopeZ,
-            data->accelerometerX,
-            data->accelerometerY,
-            data->accelerometerZ);
+    size_t destinationIndex = 0;
+    AsciiFirstCharacter(destination, destinationSize, &destinationIndex, 'I');
+    AsciiTimestamp(destination, destinationSize, &destinationIndex, data->timestamp);
+    AsciiFloat(destination, destinationSize, &destinationIndex, data->gyroscopeX);
+    AsciiFloat(destination, destinationSize, &destinationIndex, data->gyroscopeY);
+    AsciiFloat(destination, destinationSize, &destinationIndex, data->gyroscopeZ);
+    AsciiFloat(destination, destinationSize, &destinationIndex, data->accelerometerX);
+    AsciiFloat(destination, destinationSize, &destinationIndex, data->accelerometerY);
+    AsciiFloat(destination, destinationSize, &destinationIndex, data->accelerometerZ);
+    AsciiTermination(destination, destinationSize, &destinationIndex);
+    return destinationIndex;
 }
 
 /**
@@ -73,13 +70,17 @@ size_t Ximu3DataInertialAscii(void* const destination, const size_t destinationS
  * @return Message size.
  */
 size_t Ximu3DataMagnetometerBinary(void* const destination, const size_t destinationSize, const Ximu3DataMagnetometer * const data) {
+    const size_t maximumSize = BINARY_MAXIMUM_SIZE(1 + 8 + (3 * 4));
+    if (destinationSize < maximumSize) {
+        return maximumSize;
+    }
     size_t destinationIndex = 0;
-    BinaryFirstByte(destination, destinationSize, &destinationIndex, 'M');
-    BinaryTimestamp(destination, destinationSize, &destinationIndex, data->timestamp);
-    BinaryFloat(destination, destinationSize, &destinationIndex, data->x);
-    BinaryFloat(destination, destinationSize, &destinationIndex, data->y);
-    BinaryFloat(destination, destinationSize, &destinationIndex, data->z);
-    BinaryTermination(destination, destinationSize, &destinationIndex);
+    BinaryFirstByte(destination, &destinationIndex, 'M');
+    BinaryTimestamp(destination, &destinationIndex, data->timestamp);
+    BinaryFloat(destination, &destinationIndex, data->x);
+    BinaryFloat(destination, &destinationIndex, data->y);
+    BinaryFloat(destination, &destinationIndex, data->z);
+    BinaryTermination(destination, &destinationIndex);
     return destinationIndex;
 }
 
@@ -91,12 +92,14 @@ size_t Ximu3DataMagnetometerBinary(void* const destination, const size_t destina
  * @return Message size.
  */
 size_t Ximu3DataMagnetometerAscii(void* const destination, const size_t destinationSize, const Ximu3DataMagnetometer * const data) {
-    return snprintf(destination, destinationSize, "M,%" PRIu64 ","
-            FLOAT_FORMAT "," FLOAT_FORMAT "," FLOAT_FORMAT "\n",
-            data->timestamp,
-            data->x,
-            data->y,
-            data->z);
+    size_t destinationIndex = 0;
+    AsciiFirstCharacter(destination, destinationSize, &destinationIndex, 'M');
+    AsciiTimestamp(destination, destinationSize, &destinationIndex, data->timestamp);
+    AsciiFloat(destination, destinationSize, &destinationIndex, data->x);
+    AsciiFloat(destination, destinationSize, &destinationIndex, data->y);
+    AsciiFloat(destination, destinationSize, &destinationIndex, data->z);
+    AsciiTermination(destination, destinationSize, &destinationIndex);
+    return destinationIndex;
 }
 
 /**
@@ -107,14 +110,18 @@ size_t Ximu3DataMagnetometerAscii(void* const destination, const size_t destinat
  * @return Message size.
  */
 size_t Ximu3DataQuaternionBinary(void* const destination, const size_t destinationSize, const Ximu3DataQuaternion * const data) {
+    const size_t maximumSize = BINARY_MAXIMUM_SIZE(1 + 8 + (4 * 4));
+    if (destinationSize < maximumSize) {
+        return maximumSize;
+    }
     size_t destinationIndex = 0;
-    BinaryFirstByte(destination, destinationSize, &destinationIndex, 'Q');
-    BinaryTimestamp(destination, destinationSize, &destinationIndex, data->timestamp);
-    BinaryFloat(destination, destinationSize, &destinationIndex, data->w);
-    BinaryFloat(destination, destinationSize, &destinationIndex, data->x);
-    BinaryFloat(destination, destinationSize, &destinationIndex, data->y);
-    BinaryFloat(destination, destinationSize, &destinationIndex, data->z);
-    BinaryTermination(destination, destinationSize, &destinationIndex);
+    BinaryFirstByte(destination, &destinationIndex, 'Q');
+    BinaryTimestamp(destination, &destinationIndex, data->timestamp);
+    BinaryFloat(destination, &destinationIndex, data->w);
+    BinaryFloat(destination, &destinationIndex, data->x);
+    BinaryFloat(destination, &destinationIndex, data->y);
+    BinaryFloat(destination, &destinationIndex, data->z);
+    BinaryTermination(destination, &destinationIndex);
     return destinationIndex;
 }
 
@@ -126,13 +133,15 @@ size_t Ximu3DataQuaternionBinary(void* const destination, const size_t destinati
  * @return Message size.
  */
 size_t Ximu3DataQuaternionAscii(void* const destination, const size_t destinationSize, const Ximu3DataQuaternion * const data) {
-    return snprintf(destination, destinationSize, "Q,%" PRIu64 ","
-            FLOAT_FORMAT "," FLOAT_FORMAT "," FLOAT_FORMAT "," FLOAT_FORMAT "\n",
-            data->timestamp,
-            data->w,
-            data->x,
-            data->y,
-            data->z);
+    size_t destinationIndex = 0;
+    AsciiFirstCharacter(destination, destinationSize, &destinationIndex, 'Q');
+    AsciiTimestamp(destination, destinationSize, &destinationIndex, data->timestamp);
+    AsciiFloat(destination, destinationSize, &destinationIndex, data->w);
+    AsciiFloat(destination, destinationSize, &destinationIndex, data->x);
+    AsciiFloat(destination, destinationSize, &destinationIndex, data->y);
+    AsciiFloat(destination, destinationSize, &destinationIndex, data->z);
+    AsciiTermination(destination, destinationSize, &destinationIndex);
+    return destinationIndex;
 }
 
 /**
@@ -143,19 +152,23 @@ size_t Ximu3DataQuaternionAscii(void* const destination, const size_t destinatio
  * @return Message size.
  */
 size_t Ximu3DataRotationMatrixBinary(void* const destination, const size_t destinationSize, const Ximu3DataRotationMatrix * const data) {
+    const size_t maximumSize = BINARY_MAXIMUM_SIZE(1 + 8 + (9 * 4));
+    if (destinationSize < maximumSize) {
+        return maximumSize;
+    }
     size_t destinationIndex = 0;
-    BinaryFirstByte(destination, destinationSize, &destinationIndex, 'R');
-    BinaryTimestamp(destination, destinationSize, &destinationIndex, data->timestamp);
-    BinaryFloat(destination, destinationSize, &destinationIndex, data->xx);
-    BinaryFloat(destination, destinationSize, &destinationIndex, data->xy);
-    BinaryFloat(destination, destinationSize, &destinationIndex, data->xz);
-    BinaryFloat(destination, destinationSize, &destinationIndex, data->yx);
-    BinaryFloat(destination, destinationSize, &destinationIndex, data->yy);
-    BinaryFloat(destination, destinationSize, &destinationIndex, data->yz);
-    BinaryFloat(destination, destinationSize, &destinationIndex, data->zx);
-    BinaryFloat(destination, destinationSize, &destinationIndex, data->zy);
-    BinaryFloat(destination, destinationSize, &destinationIndex, data->zz);
-    BinaryTermination(destination, destinationSize, &destinationIndex);
+    BinaryFirstByte(destination, &destinationIndex, 'R');
+    BinaryTimestamp(destination, &destinationIndex, data->timestamp);
+    BinaryFloat(destination, &destinationIndex, data->xx);
+    BinaryFloat(destination, &destinationIndex, data->xy);
+    BinaryFloat(destination, &destinationIndex, data->xz);
+    BinaryFloat(destination, &destinationIndex, data->yx);
+    BinaryFloat(destination, &destinationIndex, data->yy);
+    BinaryFloat(destination, &destinationIndex, data->yz);
+    BinaryFloat(destination, &destinationIndex, data->zx);
+    BinaryFloat(destination, &destinationIndex, data->zy);
+    BinaryFloat(destination, &destinationIndex, data->zz);
+    BinaryTermination(destination, &destinationIndex);
     return destinationIndex;
 }
 
@@ -167,20 +180,20 @@ size_t Ximu3DataRotationMatrixBinary(void* const destination, const size_t desti
  * @return Message size.
  */
 size_t Ximu3DataRotationMatrixAscii(void* const destination, const size_t destinationSize, const Ximu3DataRotationMatrix * const data) {
-    return snprintf(destination, destinationSize, "R,%" PRIu64 ","
-            FLOAT_FORMAT "," FLOAT_FORMAT "," FLOAT_FORMAT ","
-            FLOAT_FORMAT "," FLOAT_FORMAT "," FLOAT_FORMAT ","
-            FLOAT_FORMAT "," FLOAT_FORMAT "," FLOAT_FORMAT "\n",
-            data->timestamp,
-            data->xx,
-            data->xy,
-            data->xz,
-            data->yx,
-            data->yy,
-            data->yz,
-            data->zx,
-            data->zy,
-            data->zz);
+    size_t destinationIndex = 0;
+    AsciiFirstCharacter(destination, destinationSize, &destinationIndex, 'R');
+    AsciiTimestamp(destination, destinationSize, &destinationIndex, data->timestamp);
+    AsciiFloat(destination, destinationSize, &destinationIndex, data->xx);
+    AsciiFloat(destination, destinationSize, &destinationIndex, data->xy);
+    AsciiFloat(destination, destinationSize, &destinationIndex, data->xz);
+    AsciiFloat(destination, destinationSize, &destinationIndex, data->yx);
+    AsciiFloat(destination, destinationSize, &destinationIndex, data->yy);
+    AsciiFloat(destination, destinationSize, &destinationIndex, data->yz);
+    AsciiFloat(destination, destinationSize, &destinationIndex, data->zx);
+    AsciiFloat(destination, destinationSize, &destinationIndex, data->zy);
+    AsciiFloat(destination, destinationSize, &destinationIndex, data->zz);
+    AsciiTermination(destination, destinationSize, &destinationIndex);
+    return destinationIndex;
 }
 
 /**
@@ -191,13 +204,17 @@ size_t Ximu3DataRotationMatrixAscii(void* const destination, const size_t destin
  * @return Message size.
  */
 size_t Ximu3DataEulerAnglesBinary(void* const destination, const size_t destinationSize, const Ximu3DataEulerAngles * const data) {
+    const size_t maximumSize = BINARY_MAXIMUM_SIZE(1 + 8 + (3 * 4));
+    if (destinationSize < maximumSize) {
+        return maximumSize;
+    }
     size_t destinationIndex = 0;
-    BinaryFirstByte(destination, destinationSize, &destinationIndex, 'A');
-    BinaryTimestamp(destination, destinationSize, &destinationIndex, data->timestamp);
-    BinaryFloat(destination, destinationSize, &destinationIndex, data->roll);
-    BinaryFloat(destination, destinationSize, &destinationIndex, data->pitch);
-    BinaryFloat(destination, destinationSize, &destinationIndex, data->yaw);
-    BinaryTermination(destination, destinationSize, &destinationIndex);
+    BinaryFirstByte(destination, &destinationIndex, 'A');
+    BinaryTimestamp(destination, &destinationIndex, data->timestamp);
+    BinaryFloat(destination, &destinationIndex, data->roll);
+    BinaryFloat(destination, &destinationIndex, data->pitch);
+    BinaryFloat(destination, &destinationIndex, data->yaw);
+    BinaryTermination(destination, &destinationIndex);
     return destinationIndex;
 }
 
@@ -209,12 +226,14 @@ size_t Ximu3DataEulerAnglesBinary(void* const destination, const size_t destinat
  * @return Message size.
  */
 size_t Ximu3DataEulerAnglesAscii(void* const destination, const size_t destinationSize, const Ximu3DataEulerAngles * const data) {
-    return snprintf(destination, destinationSize, "A,%" PRIu64 ","
-            FLOAT_FORMAT "," FLOAT_FORMAT "," FLOAT_FORMAT "\n",
-            data->timestamp,
-            data->roll,
-            data->pitch,
-            data->yaw);
+    size_t destinationIndex = 0;
+    AsciiFirstCharacter(destination, destinationSize, &destinationIndex, 'A');
+    AsciiTimestamp(destination, destinationSize, &destinationIndex, data->timestamp);
+    AsciiFloat(destination, destinationSize, &destinationIndex, data->roll);
+    AsciiFloat(destination, destinationSize, &destinationIndex, data->pitch);
+    AsciiFloat(destination, destinationSize, &destinationIndex, data->yaw);
+    AsciiTermination(destination, destinationSize, &destinationIndex);
+    return destinationIndex;
 }
 
 /**
@@ -225,17 +244,21 @@ size_t Ximu3DataEulerAnglesAscii(void* const destination, const size_t destinati
  * @return Message size.
  */
 size_t Ximu3DataLinearAccelerationBinary(void* const destination, const size_t destinationSize, const Ximu3DataLinearAcceleration * const data) {
+    const size_t maximumSize = BINARY_MAXIMUM_SIZE(1 + 8 + (7 * 4));
+    if (destinationSize < maximumSize) {
+        return maximumSize;
+    }
     size_t destinationIndex = 0;
-    BinaryFirstByte(destination, destinationSize, &destinationIndex, 'L');
-    BinaryTimestamp(destination, destinationSize, &destinationIndex, data->timestamp);
-    BinaryFloat(destination, destinationSize, &destinationIndex, data->quaternionW);
-    BinaryFloat(destination, destinationSize, &destinationIndex, data->quaternionX);
-    BinaryFloat(destination, destinationSize, &destinationIndex, data->quaternionY);
-    BinaryFloat(destination, destinationSize, &destinationIndex, data->quaternionZ);
-    BinaryFloat(destination, destinationSize, &destinationIndex, data->linearAccelerationX);
-    BinaryFloat(destination, destinationSize, &destinationIndex, data->linearAccelerationY);
-    BinaryFloat(destination, destinationSize, &destinationIndex, data->linearAccelerationZ);
-    BinaryTermination(destination, destinationSize, &destinationIndex);
+    BinaryFirstByte(destination, &destinationIndex, 'L');
+    BinaryTimestamp(destination, &destinationIndex, data->timestamp);
+    BinaryFloat(destination, &destinationIndex, data->quaternionW);
+    BinaryFloat(destination, &destinationIndex, data->quaternionX);
+    BinaryFloat(destination, &destinationIndex, data->quaternionY);
+    BinaryFloat(destination, &destinationIndex, data->quaternionZ);
+    BinaryFloat(destination, &destinationIndex, data->linearAccelerationX);
+    BinaryFloat(destination, &destinationIndex, data->linearAccelerationY);
+    BinaryFloat(destination, &destinationIndex, data->linearAccelerationZ);
+    BinaryTermination(destination, &destinationIndex);
     return destinationIndex;
 }
 
@@ -247,17 +270,18 @@ size_t Ximu3DataLinearAccelerationBinary(void* const destination, const size_t d
  * @return Message size.
  */
 size_t Ximu3DataLinearAccelerationAscii(void* const destination, const size_t destinationSize, const Ximu3DataLinearAcceleration * const data) {
-    return snprintf(destination, destinationSize, "L,%" PRIu64 ","
-            FLOAT_FORMAT "," FLOAT_FORMAT "," FLOAT_FORMAT "," FLOAT_FORMAT ","
-            FLOAT_FORMAT "," FLOAT_FORMAT "," FLOAT_FORMAT "\n",
-            data->timestamp,
-            data->quaternionW,
-            data->quaternionX,
-            data->quaternionY,
-            data->quaternionZ,
-            data->linearAccelerationX,
-            data->linearAccelerationY,
-            data->linearAccelerationZ);
+    size_t destinationIndex = 0;
+    AsciiFirstCharacter(destination, destinationSize, &destinationIndex, 'L');
+    AsciiTimestamp(destination, destinationSize, &destinationIndex, data->timestamp);
+    AsciiFloat(destination, destinationSize, &destinationIndex, data->quaternionW);
+    AsciiFloat(destination, destinationSize, &destinationIndex, data->quaternionX);
+    AsciiFloat(destination, destinationSize, &destinationIndex, data->quaternionY);
+    AsciiFloat(destination, destinationSize, &destinationIndex, data->quaternionZ);
+    AsciiFloat(destination, destinationSize, &destinationIndex, data->linearAccelerationX);
+    AsciiFloat(destination, destinationSize, &destinationIndex, data->linearAccelerationY);
+    AsciiFloat(destination, destinationSize, &destinationIndex, data->linearAccelerationZ);
+    AsciiTermination(destination, destinationSize, &destinationIndex);
+    return destinationIndex;
 }
 
 /**
@@ -268,17 +292,21 @@ size_t Ximu3DataLinearAccelerationAscii(void* const destination, const size_t de
  * @return Message size.
  */
 size_t Ximu3DataEarthAccelerationBinary(void* const destination, const size_t destinationSize, const Ximu3DataEarthAcceleration * const data) {
+    const size_t maximumSize = BINARY_MAXIMUM_SIZE(1 + 8 + (7 * 4));
+    if (destinationSize < maximumSize) {
+        return maximumSize;
+    }
     size_t destinationIndex = 0;
-    BinaryFirstByte(destination, destinationSize, &destinationIndex, 'E');
-    BinaryTimestamp(destination, destinationSize, &destinationIndex, data->timestamp);
-    BinaryFloat(destination, destinationSize, &destinationIndex, data->quaternionW);
-    BinaryFloat(destination, destinationSize, &destinationIndex, data->quaternionX);
-    BinaryFloat(destination, destinationSize, &destinationIndex, data->quaternionY);
-    BinaryFloat(destination, destinationSize, &destinationIndex, data->quaternionZ);
-    BinaryFloat(destination, destinationSize, &destinationIndex, data->earthAccelerationX);
-    BinaryFloat(destination, destinationSize, &destinationIndex, data->earthAccelerationY);
-    BinaryFloat(destination, destinationSize, &destinationIndex, data->earthAccelerationZ);
-    BinaryTermination(destination, destinationSize, &destinationIndex);
+    BinaryFirstByte(destination, &destinationIndex, 'E');
+    BinaryTimestamp(destination, &destinationIndex, data->timestamp);
+    BinaryFloat(destination, &destinationIndex, data->quaternionW);
+    BinaryFloat(destination, &destinationIndex, data->quaternionX);
+    BinaryFloat(destination, &destinationIndex, data->quaternionY);
+    BinaryFloat(destination, &destinationIndex, data->quaternionZ);
+    BinaryFloat(destination, &destinationIndex, data->earthAccelerationX);
+    BinaryFloat(destination, &destinationIndex, data->earthAccelerationY);
+    BinaryFloat(destination, &destinationIndex, data->earthAccelerationZ);
+    BinaryTermination(destination, &destinationIndex);
     return destinationIndex;
 }
 
@@ -290,17 +318,18 @@ size_t Ximu3DataEarthAccelerationBinary(void* const destination, const size_t de
  * @return Message size.
  */
 size_t Ximu3DataEarthAccelerationAscii(void* const destination, const size_t destinationSize, const Ximu3DataEarthAcceleration * const data) {
-    return snprintf(destination, destinationSize, "E,%" PRIu64 ","
-            FLOAT_FORMAT "," FLOAT_FORMAT "," FLOAT_FORMAT "," FLOAT_FORMAT ","
-            FLOAT_FORMAT "," FLOAT_FORMAT "," FLOAT_FORMAT "\n",
-            data->timestamp,
-            data->quaternionW,
-            data->quaternionX,
-            data->quaternionY,
-            data->quaternionZ,
-            data->earthAccelerationX,
-            data->earthAccelerationY,
-            data->earthAccelerationZ);
+    size_t destinationIndex = 0;
+    AsciiFirstCharacter(destination, destinationSize, &destinationIndex, 'E');
+    AsciiTimestamp(destination, destinationSize, &destinationIndex, data->timestamp);
+    AsciiFloat(destination, destinationSize, &destinationIndex, data->quaternionW);
+    AsciiFloat(destination, destinationSize, &destinationIndex, data->quaternionX);
+    AsciiFloat(destination, destinationSize, &destinationIndex, data->quaternionY);
+    AsciiFloat(destination, destinationSize, &destinationIndex, data->quaternionZ);
+    AsciiFloat(destination, destinationSize, &destinationIndex, data->earthAccelerationX);
+    AsciiFloat(destination, destinationSize, &destinationIndex, data->earthAccelerationY);
+    AsciiFloat(destination, destinationSize, &destinationIndex, data->earthAccelerationZ);
+    AsciiTermination(destination, destinationSize, &destinationIndex);
+    return destinationIndex;
 }
 
 /**
@@ -311,14 +340,18 @@ size_t Ximu3DataEarthAccelerationAscii(void* const destination, const size_t des
  * @return Message size.
  */
 size_t Ximu3DataAhrsStatusBinary(void* const destination, const size_t destinationSize, const Ximu3DataAhrsStatus * const data) {
+    const size_t maximumSize = BINARY_MAXIMUM_SIZE(1 + 8 + (4 * 4));
+    if (destinationSize < maximumSize) {
+        return maximumSize;
+    }
     size_t destinationIndex = 0;
-    BinaryFirstByte(destination, destinationSize, &destinationIndex, 'U');
-    BinaryTimestamp(destination, destinationSize, &destinationIndex, data->timestamp);
-    BinaryFloat(destination, destinationSize, &destinationIndex, (float) data->initialising);
-    BinaryFloat(destination, destinationSize, &destinationIndex, (float) data->angularRateRecovery);
-    BinaryFloat(destination, destinationSize, &destinationIndex, (float) data->accelerationRecovery);
-    BinaryFloat(destination, destinationSize, &destinationIndex, (float) data->magneticRecovery);
-    BinaryTermination(destination, destinationSize, &destinationIndex);
+    BinaryFirstByte(destination, &destinationIndex, 'U');
+    BinaryTimestamp(destination, &destinationIndex, data->timestamp);
+    BinaryFloat(destination, &destinationIndex, (float) data->initialising);
+    BinaryFloat(destination, &destinationIndex, (float) data->angularRateRecovery);
+    BinaryFloat(destination, &destinationIndex, (float) data->accelerationRecovery);
+    BinaryFloat(destination, &destinationIndex, (float) data->magneticRecovery);
+    BinaryTermination(destination, &destinationIndex);
     return destinationIndex;
 }
 
@@ -330,13 +363,15 @@ size_t Ximu3DataAhrsStatusBinary(void* const destination, const size_t destinati
  * @return Message size.
  */
 size_t Ximu3DataAhrsStatusAscii(void* const destination, const size_t destinationSize, const Ximu3DataAhrsStatus * const data) {
-    return snprintf(destination, destinationSize, "U,%" PRIu64 ","
-            FLOAT_FORMAT "," FLOAT_FORMAT "," FLOAT_FORMAT "," FLOAT_FORMAT "\n",
-            data->timestamp,
-            (float) data->initialising,
-            (float) data->angularRateRecovery,
-            (float) data->accelerationRecovery,
-            (float) data->magneticRecovery);
+    size_t destinationIndex = 0;
+    AsciiFirstCharacter(destination, destinationSize, &destinationIndex, 'U');
+    AsciiTimestamp(destination, destinationSize, &destinationIndex, data->timestamp);
+    AsciiFloat(destination, destinationSize, &destinationIndex, (float) data->initialising);
+    AsciiFloat(destination, destinationSize, &destinationIndex, (float) data->angularRateRecovery);
+    AsciiFloat(destination, destinationSize, &destinationIndex, (float) data->accelerationRecovery);
+    AsciiFloat(destination, destinationSize, &destinationIndex, (float) data->magneticRecovery);
+    AsciiTermination(destination, destinationSize, &destinationIndex);
+    return destinationIndex;
 }
 
 /**
@@ -347,13 +382,17 @@ size_t Ximu3DataAhrsStatusAscii(void* const destination, const size_t destinatio
  * @return Message size.
  */
 size_t Ximu3DataHighGAccelerometerBinary(void* const destination, const size_t destinationSize, const Ximu3DataHighGAccelerometer * const data) {
+    const size_t maximumSize = BINARY_MAXIMUM_SIZE(1 + 8 + (3 * 4));
+    if (destinationSize < maximumSize) {
+        return maximumSize;
+    }
     size_t destinationIndex = 0;
-    BinaryFirstByte(destination, destinationSize, &destinationIndex, 'H');
-    BinaryTimestamp(destination, destinationSize, &destinationIndex, data->timestamp);
-    BinaryFloat(destination, destinationSize, &destinationIndex, data->x);
-    BinaryFloat(destination, destinationSize, &destinationIndex, data->y);
-    BinaryFloat(destination, destinationSize, &destinationIndex, data->z);
-    BinaryTermination(destination, destinationSize, &destinationIndex);
+    BinaryFirstByte(destination, &destinationIndex, 'H');
+    BinaryTimestamp(destination, &destinationIndex, data->timestamp);
+    BinaryFloat(destination, &destinationIndex, data->x);
+    BinaryFloat(destination, &destinationIndex, data->y);
+    BinaryFloat(destination, &destinationIndex, data->z);
+    BinaryTermination(destination, &destinationIndex);
     return destinationIndex;
 }
 
@@ -365,12 +404,14 @@ size_t Ximu3DataHighGAccelerometerBinary(void* const destination, const size_t d
  * @return Message size.
  */
 size_t Ximu3DataHighGAccelerometerAscii(void* const destination, const size_t destinationSize, const Ximu3DataHighGAccelerometer * const data) {
-    return snprintf(destination, destinationSize, "H,%" PRIu64 ","
-            FLOAT_FORMAT "," FLOAT_FORMAT "," FLOAT_FORMAT "\n",
-            data->timestamp,
-            data->x,
-            data->y,
-            data->z);
+    size_t destinationIndex = 0;
+    AsciiFirstCharacter(destination, destinationSize, &destinationIndex, 'H');
+    AsciiTimestamp(destination, destinationSize, &destinationIndex, data->timestamp);
+    AsciiFloat(destination, destinationSize, &destinationIndex, data->x);
+    AsciiFloat(destination, destinationSize, &destinationIndex, data->y);
+    AsciiFloat(destination, destinationSize, &destinationIndex, data->z);
+    AsciiTermination(destination, destinationSize, &destinationIndex);
+    return destinationIndex;
 }
 
 /**
@@ -381,11 +422,15 @@ size_t Ximu3DataHighGAccelerometerAscii(void* const destination, const size_t de
  * @return Message size.
  */
 size_t Ximu3DataTemperatureBinary(void* const destination, const size_t destinationSize, const Ximu3DataTemperature * const data) {
+    const size_t maximumSize = BINARY_MAXIMUM_SIZE(1 + 8 + 4);
+    if (destinationSize < maximumSize) {
+        return maximumSize;
+    }
     size_t destinationIndex = 0;
-    BinaryFirstByte(destination, destinationSize, &destinationIndex, 'T');
-    BinaryTimestamp(destination, destinationSize, &destinationIndex, data->timestamp);
-    BinaryFloat(destination, destinationSize, &destinationIndex, data->temperature);
-    BinaryTermination(destination, destinationSize, &destinationIndex);
+    BinaryFirstByte(destination, &destinationIndex, 'T');
+    BinaryTimestamp(destination, &destinationIndex, data->timestamp);
+    BinaryFloat(destination, &destinationIndex, data->temperature);
+    BinaryTermination(destination, &destinationIndex);
     return destinationIndex;
 }
 
@@ -397,9 +442,48 @@ size_t Ximu3DataTemperatureBinary(void* const destination, const size_t destinat
  * @return Message size.
  */
 size_t Ximu3DataTemperatureAscii(void* const destination, const size_t destinationSize, const Ximu3DataTemperature * const data) {
-    return snprintf(destination, destinationSize, "T,%" PRIu64 "," FLOAT_FORMAT "\n",
-            data->timestamp,
-            data->temperature);
+    size_t destinationIndex = 0;
+    AsciiFirstCharacter(destination, destinationSize, &destinationIndex, 'T');
+    AsciiTimestamp(destination, destinationSize, &destinationIndex, data->timestamp);
+    AsciiFloat(destination, destinationSize, &destinationIndex, data->temperature);
+    AsciiTermination(destination, destinationSize, &destinationIndex);
+    return destinationIndex;
+}
+
+/**
+ * @brief Writes binary fixed-point temperature data message.
+ * @param destination Destination.
+ * @param destinationSize Destination size.
+ * @param data Data.
+ * @return Message size.
+ */
+size_t Ximu3DataTemperatureFixedBinary(void* const destination, const size_t destinationSize, const Ximu3DataTemperatureFixed * const data) {
+    const size_t maximumSize = BINARY_MAXIMUM_SIZE(1 + 8 + 4);
+    if (destinationSize < maximumSize) {
+        return maximumSize;
+    }
+    size_t destinationIndex = 0;
+    BinaryFirstByte(destination, &destinationIndex, 'T');
+    BinaryTimestamp(destination, &destinationIndex, data->timestamp);
+    BinaryFixed(destination, &destinationIndex, data->temperature, 7);
+    BinaryTermination(destination, &destinationIndex);
+    return destinationIndex;
+}
+
+/**
+ * @brief Writes ASCII fixed-point temperature data message.
+ * @param destination Destination.
+ * @param destinationSize Destination size.
+ * @param data Data.
+ * @return Message size.
+ */
+size_t Ximu3DataTemperatureFixedAscii(void* const destination, const size_t destinationSize, const Ximu3DataTemperatureFixed * const data) {
+    size_t destinationIndex = 0;
+    AsciiFirstCharacter(destination, destinationSize, &destinationIndex, 'T');
+    AsciiTimestamp(destination, destinationSize, &destinationIndex, data->timestamp);
+    AsciiFixed(destination, destinationSize, &destinationIndex, data->temperature, 7);
+    AsciiTermination(destination, destinationSize, &destinationIndex);
+    return destinationIndex;
 }
 
 /**
@@ -410,13 +494,17 @@ size_t Ximu3DataTemperatureAscii(void* const destination, const size_t destinati
  * @return Message size.
  */
 size_t Ximu3DataBatteryBinary(void* const destination, const size_t destinationSize, const Ximu3DataBattery * const data) {
+    const size_t maximumSize = BINARY_MAXIMUM_SIZE(1 + 8 + (3 * 4));
+    if (destinationSize < maximumSize) {
+        return maximumSize;
+    }
     size_t destinationIndex = 0;
-    BinaryFirstByte(destination, destinationSize, &destinationIndex, 'B');
-    BinaryTimestamp(destination, destinationSize, &destinationIndex, data->timestamp);
-    BinaryFloat(destination, destinationSize, &destinationIndex, data->percentage);
-    BinaryFloat(destination, destinationSize, &destinationIndex, data->voltage);
-    BinaryFloat(destination, destinationSize, &destinationIndex, data->chargingStatus);
-    BinaryTermination(destination, destinationSize, &destinationIndex);
+    BinaryFirstByte(destination, &destinationIndex, 'B');
+    BinaryTimestamp(destination, &destinationIndex, data->timestamp);
+    BinaryFloat(destination, &destinationIndex, data->percentage);
+    BinaryFloat(destination, &destinationIndex, data->voltage);
+    BinaryFloat(destination, &destinationIndex, data->chargingStatus);
+    BinaryTermination(destination, &destinationIndex);
     return destinationIndex;
 }
 
@@ -428,11 +516,14 @@ size_t Ximu3DataBatteryBinary(void* const destination, const size_t destinationS
  * @return Message size.
  */
 size_t Ximu3DataBatteryAscii(void* const destination, const size_t destinationSize, const Ximu3DataBattery * const data) {
-    return snprintf(destination, destinationSize, "B,%" PRIu64 "," FLOAT_FORMAT "," FLOAT_FORMAT "," FLOAT_FORMAT "\n",
-            data->timestamp,
-            data->percentage,
-            data->voltage,
-            data->chargingStatus);
+    size_t destinationIndex = 0;
+    AsciiFirstCharacter(destination, destinationSize, &destinationIndex, 'B');
+    AsciiTimestamp(destination, destinationSize, &destinationIndex, data->timestamp);
+    AsciiFloat(destination, destinationSize, &destinationIndex, data->percentage);
+    AsciiFloat(destination, destinationSize, &destinationIndex, data->voltage);
+    AsciiFloat(destination, destinationSize, &destinationIndex, data->chargingStatus);
+    AsciiTermination(destination, destinationSize, &destinationIndex);
+    return destinationIndex;
 }
 
 /**
@@ -443,12 +534,16 @@ size_t Ximu3DataBatteryAscii(void* const destination, const size_t destinationSi
  * @return Message size.
  */
 size_t Ximu3DataRssiBinary(void* const destination, const size_t destinationSize, const Ximu3DataRssi * const data) {
+    const size_t maximumSize = BINARY_MAXIMUM_SIZE(1 + 8 + (2 * 4));
+    if (destinationSize < maximumSize) {
+        return maximumSize;
+    }
     size_t destinationIndex = 0;
-    BinaryFirstByte(destination, destinationSize, &destinationIndex, 'W');
-    BinaryTimestamp(destination, destinationSize, &destinationIndex, data->timestamp);
-    BinaryFloat(destination, destinationSize, &destinationIndex, data->percentage);
-    BinaryFloat(destination, destinationSize, &destinationIndex, data->power);
-    BinaryTermination(destination, destinationSize, &destinationIndex);
+    BinaryFirstByte(destination, &destinationIndex, 'W');
+    BinaryTimestamp(destination, &destinationIndex, data->timestamp);
+    BinaryFloat(destination, &destinationIndex, data->percentage);
+    BinaryFloat(destination, &destinationIndex, data->power);
+    BinaryTermination(destination, &destinationIndex);
     return destinationIndex;
 }
 
@@ -460,10 +555,13 @@ size_t Ximu3DataRssiBinary(void* const destination, const size_t destinationSize
  * @return Message size.
  */
 size_t Ximu3DataRssiAscii(void* const destination, const size_t destinationSize, const Ximu3DataRssi * const data) {
-    return snprintf(destination, destinationSize, "W,%" PRIu64 "," FLOAT_FORMAT "," FLOAT_FORMAT "\n",
-            data->timestamp,
-            data->percentage,
-            data->power);
+    size_t destinationIndex = 0;
+    AsciiFirstCharacter(destination, destinationSize, &destinationIndex, 'W');
+    AsciiTimestamp(destination, destinationSize, &destinationIndex, data->timestamp);
+    AsciiFloat(destination, destinationSize, &destinationIndex, data->percentage);
+    AsciiFloat(destination, destinationSize, &destinationIndex, data->power);
+    AsciiTermination(destination, destinationSize, &destinationIndex);
+    return destinationIndex;
 }
 
 /**
@@ -474,13 +572,15 @@ size_t Ximu3DataRssiAscii(void* const destination, const size_t destinationSize,
  * @return Message size.
  */
 size_t Ximu3DataSerialAccessoryBinary(void* const destination, const size_t destinationSize, const Ximu3DataSerialAccessory * const data) {
-    size_t destinationIndex = 0;
-    BinaryFirstByte(destination, destinationSize, &destinationIndex, 'S');
-    BinaryTimestamp(destination, destinationSize, &destinationIndex, data->timestamp);
-    for (size_t index = 0; index < data->numberOfBytes; index++) {
-        BinaryWrite(destination, destinationSize, &destinationIndex, data->data[index]);
+    const size_t maximumSize = BINARY_MAXIMUM_SIZE(1 + 8 + data->numberOfBytes);
+    if (destinationSize < maximumSize) {
+        return maximumSize;
     }
-    BinaryTermination(destination, destinationSize, &destinationIndex);
+    size_t destinationIndex = 0;
+    BinaryFirstByte(destination, &destinationIndex, 'S');
+    BinaryTimestamp(destination, &destinationIndex, data->timestamp);
+    BinaryBytes(destination, &destinationIndex, data->data, data->numberOfBytes);
+    BinaryTermination(destination, &destinationIndex);
     return destinationIndex;
 }
 
@@ -492,7 +592,10 @@ size_t Ximu3DataSerialAccessoryBinary(void* const destination, const size_t dest
  * @return Message size.
  */
 size_t Ximu3DataSerialAccessoryAscii(void* const destination, const size_t destinationSize, const Ximu3DataSerialAccessory * const data) {
-    size_t destinationIndex = snprintf(destination, destinationSize, "S,%" PRIu64 ",", data->timestamp);
+    size_t destinationIndex = 0;
+    AsciiFirstCharacter(destination, destinationSize, &destinationIndex, 'S');
+    AsciiTimestamp(destination, destinationSize, &destinationIndex, data->timestamp);
+    AsciiCharacter(destination, destinationSize, &destinationIndex, ',');
     if ((destinationIndex + data->numberOfBytes + 1) > destinationSize) {
         return 0;
     }
@@ -512,11 +615,15 @@ size_t Ximu3DataSerialAccessoryAscii(void* const destination, const size_t desti
  * @return Message size.
  */
 size_t Ximu3DataNotificationBinary(void* const destination, const size_t destinationSize, const Ximu3DataNotification * const data) {
+    const size_t maximumSize = BINARY_MAXIMUM_SIZE(1 + 8 + strlen(data->string));
+    if (destinationSize < maximumSize) {
+        return maximumSize;
+    }
     size_t destinationIndex = 0;
-    BinaryFirstByte(destination, destinationSize, &destinationIndex, 'N');
-    BinaryTimestamp(destination, destinationSize, &destinationIndex, data->timestamp);
-    BinaryString(destination, destinationSize, &destinationIndex, data->string);
-    BinaryTermination(destination, destinationSize, &destinationIndex);
+    BinaryFirstByte(destination, &destinationIndex, 'N');
+    BinaryTimestamp(destination, &destinationIndex, data->timestamp);
+    BinaryString(destination, &destinationIndex, data->string);
+    BinaryTermination(destination, &destinationIndex);
     return destinationIndex;
 }
 
@@ -528,7 +635,12 @@ size_t Ximu3DataNotificationBinary(void* const destination, const size_t destina
  * @return Message size.
  */
 size_t Ximu3DataNotificationAscii(void* const destination, const size_t destinationSize, const Ximu3DataNotification * const data) {
-    return snprintf(destination, destinationSize, "N,%" PRIu64 ",%s\n", data->timestamp, data->string);
+    size_t destinationIndex = 0;
+    AsciiFirstCharacter(destination, destinationSize, &destinationIndex, 'N');
+    AsciiTimestamp(destination, destinationSize, &destinationIndex, data->timestamp);
+    AsciiString(destination, destinationSize, &destinationIndex, data->string);
+    AsciiTermination(destination, destinationSize, &destinationIndex);
+    return destinationIndex;
 }
 
 /**
@@ -539,11 +651,15 @@ size_t Ximu3DataNotificationAscii(void* const destination, const size_t destinat
  * @return Message size.
  */
 size_t Ximu3DataErrorBinary(void* const destination, const size_t destinationSize, const Ximu3DataError * const data) {
+    const size_t maximumSize = BINARY_MAXIMUM_SIZE(1 + 8 + strlen(data->string));
+    if (destinationSize < maximumSize) {
+        return maximumSize;
+    }
     size_t destinationIndex = 0;
-    BinaryFirstByte(destination, destinationSize, &destinationIndex, 'F');
-    BinaryTimestamp(destination, destinationSize, &destinationIndex, data->timestamp);
-    BinaryString(destination, destinationSize, &destinationIndex, data->string);
-    BinaryTermination(destination, destinationSize, &destinationIndex);
+    BinaryFirstByte(destination, &destinationIndex, 'F');
+    BinaryTimestamp(destination, &destinationIndex, data->timestamp);
+    BinaryString(destination, &destinationIndex, data->string);
+    BinaryTermination(destination, &destinationIndex);
     return destinationIndex;
 }
 
@@ -555,7 +671,12 @@ size_t Ximu3DataErrorBinary(void* const destination, const size_t destinationSiz
  * @return Message size.
  */
 size_t Ximu3DataErrorAscii(void* const destination, const size_t destinationSize, const Ximu3DataError * const data) {
-    return snprintf(destination, destinationSize, "F,%" PRIu64 ",%s\n", data->timestamp, data->string);
+    size_t destinationIndex = 0;
+    AsciiFirstCharacter(destination, destinationSize, &destinationIndex, 'F');
+    AsciiTimestamp(destination, destinationSize, &destinationIndex, data->timestamp);
+    AsciiString(destination, destinationSize, &destinationIndex, data->string);
+    AsciiTermination(destination, destinationSize, &destinationIndex);
+    return destinationIndex;
 }
 
 //------------------------------------------------------------------------------
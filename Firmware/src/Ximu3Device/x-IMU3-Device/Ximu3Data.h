@@ -134,6 +134,16 @@ typedef struct {
     float temperature;
 } Ximu3DataTemperature;
 
+/**
+ * @brief Temperature data message with a fixed-point temperature. The message
+ * is identical to the temperature data message but is written without
+ * floating-point arithmetic.
+ */
+typedef struct {
+    uint64_t timestamp;
+    int16_t temperature; // 1/128 degree Celsius
+} Ximu3DataTemperatureFixed;
+
 /**
  * @brief Battery data message.
  */
@@ -201,6 +211,8 @@ size_t Ximu3DataHighGAccelerometerBinary(void* const destination, const size_t d
 size_t Ximu3DataHighGAccelerometerAscii(void* const destination, const size_t destinationSize, const Ximu3DataHighGAccelerometer * const data);
 size_t Ximu3DataTemperatureBinary(void* const destination, const size_t destinationSize, const Ximu3DataTemperature * const data);
 size_t Ximu3DataTemperatureAscii(void* const destination, const size_t destinationSize, const Ximu3DataTemperature * const data);
+size_t Ximu3DataTemperatureFixedBinary(void* const destination, const size_t destinationSize, const Ximu3DataTemperatureFixed * const data);
+size_t Ximu3DataTemperatureFixedAscii(void* const destination, const size_t destinationSize, const Ximu3DataTemperatureFixed * const data);
 size_t Ximu3DataBatteryBinary(void* const destination, const size_t destinationSize, const Ximu3DataBattery * const data);
 size_t Ximu3DataBatteryAscii(void* const destination, const size_t destinationSize, const Ximu3DataBattery * const data);
 size_t Ximu3DataRssiBinary(void* const destination, const size_t destinationSize, const Ximu3DataRssi * const data);
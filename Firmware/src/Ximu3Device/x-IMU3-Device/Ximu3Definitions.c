@@ -34,6 +34,18 @@ Ximu3Result Ximu3SettingsIndexFrom(Ximu3SettingsIndex * const index, const int i
         case Ximu3SettingsIndexSerialDataMessagesEnabled:
             *index = Ximu3SettingsIndexSerialDataMessagesEnabled;
             break;
+        case Ximu3SettingsIndexTemperatureRate:
+            *index = Ximu3SettingsIndexTemperatureRate;
+            break;
+        case Ximu3SettingsIndexTemperatureMedianSize:
+            *index = Ximu3SettingsIndexTemperatureMedianSize;
+            break;
+        case Ximu3SettingsIndexTemperatureDecimation:
+            *index = Ximu3SettingsIndexTemperatureDecimation;
+            break;
+        case Ximu3SettingsIndexTemperatureLowPassShift:
+            *index = Ximu3SettingsIndexTemperatureLowPassShift;
+            break;
         case Ximu3SettingsIndexExampleFloat:
             *index = Ximu3SettingsIndexExampleFloat;
             break;
@@ -16,7 +16,7 @@
 
 #define XIMU3_MAX_KEY_LENGTH 28
 
-#define XIMU3_NUMBER_OF_SETTINGS 11
+#define XIMU3_NUMBER_OF_SETTINGS 15
 
 #define XIMU3_MUX_HEADER_SIZE 2
 
@@ -36,6 +36,10 @@ typedef struct {
     bool binaryModeEnabled;
     bool usbDataMessagesEnabled;
     bool serialDataMessagesEnabled;
+    float temperatureRate;
+    uint32_t temperatureMedianSize;
+    uint32_t temperatureDecimation;
+    uint32_t temperatureLowPassShift;
     float exampleFloat;
 } Ximu3SettingsValues;
 
@@ -50,6 +54,10 @@ typedef enum {
     Ximu3SettingsIndexBinaryModeEnabled,
     Ximu3SettingsIndexUsbDataMessagesEnabled,
     Ximu3SettingsIndexSerialDataMessagesEnabled,
+    Ximu3SettingsIndexTemperatureRate,
+    Ximu3SettingsIndexTemperatureMedianSize,
+    Ximu3SettingsIndexTemperatureDecimation,
+    Ximu3SettingsIndexTemperatureLowPassShift,
     Ximu3SettingsIndexExampleFloat,
 } Ximu3SettingsIndex;
 
@@ -8,7 +8,6 @@
 // Includes
 
 #include <inttypes.h>
-#include "Key.h"
 #include "Metadata.h"
 #include <stdio.h>
 #include <string.h>
@@ -28,20 +27,15 @@ static JsonResult ParseUint32(Ximu3Settings * const settings, const Ximu3Setting
 // Functions
 
 /**
- * @brief Gets the index.
+ * @brief Gets the index. The key is found using the perfect hash table
+ * generated by generate.py.
  * @param settings Settings.
- * @param index_ Index.
+ * @param index Index.
  * @param key Key.
  * @return Result.
  */
-Ximu3Result Ximu3SettingsJsonGetIndex(Ximu3Settings * const settings, Ximu3SettingsIndex * const index_, const char* const key) {
-    for (int index = 0; index < XIMU3_NUMBER_OF_SETTINGS; index++) {
-        if (KeyMatches(key, MetadataGet(settings, index).key)) {
-            *index_ = index;
-            return Ximu3ResultOk;
-        }
-    }
-    return Ximu3ResultError;
+Ximu3Result Ximu3SettingsJsonGetIndex(Ximu3Settings * const settings, Ximu3SettingsIndex * const index, const char* const key) {
+    return MetadataGetIndex(index, key);
 }
 
 /**
@@ -25,6 +25,49 @@ def snake_case(string: str) -> str:
     return "_".join([w.lower() for w in split_words(string)])
 
 
+def normalise_key(string: str) -> str:
+    return re.sub("[^0-9a-z]", "", string.lower())  # must match KeyNormalise() in Key.c
+
+
+def key_hash(string: str, seed: int) -> int:
+    hash = seed  # must match KeyHash() in Key.c
+    for byte in string.encode():
+        hash ^= byte
+        hash = (hash * 16777619) & 0xFFFFFFFF
+    return hash
+
+
+def hash_slot(hash: int, displacement: int, bits: int) -> int:
+    return (((hash ^ displacement) * 0x9E3779B1) & 0xFFFFFFFF) >> (32 - bits)  # must match MetadataGetIndex() in Metadata.c
+
+
+def perfect_hash(keys: list[str]) -> tuple[int, int, list[int], list[int]]:  # hash and displace
+    bits = 1
+    while (1 << bits) < len(keys):
+        bits += 1
+    seed = 0x811C9DC5
+    while len({key_hash(k, seed) for k in keys}) != len(keys):
+        seed += 1
+    buckets = [[] for _ in range(1 << bits)]
+    for index, key in enumerate(keys):
+        buckets[key_hash(key, seed) >> (32 - bits)].append(index)
+    displacements = [0] * (1 << bits)
+    table = [-1] * (1 << bits)
+    for bucket in sorted(range(1 << bits), key=lambda b: -len(buckets[b])):
+        if not buckets[bucket]:
+            break
+        displacement = 0
+        while True:
+            slots = [hash_slot(key_hash(keys[i], seed), displacement, bits) for i in buckets[bucket]]
+            if len(set(slots)) == len(slots) and all(table[s] == -1 for s in slots):
+                break
+            displacement += 1
+        displacements[bucket] = displacement
+        for index, slot in zip(buckets[bucket], slots):
+            table[slot] = index
+    return seed, bits, displacements, table
+
+
 # Load Settings.json
 with open("Settings.json") as file:
     object = json.load(file)
@@ -153,6 +196,8 @@ typedef struct {{
 
 Metadata MetadataGet(Ximu3Settings * const settings, const Ximu3SettingsIndex index);
 
+Ximu3Result MetadataGetIndex(Ximu3SettingsIndex * const index, const char* const key);
+
 #endif
 """
 
@@ -164,6 +209,19 @@ names = "\n".join([f'    "{title_case(s["name"])}",' for s in settings])
 
 keys = "\n".join([f'    "{snake_case(s["name"])}",' for s in settings])
 
+normalised_keys = [normalise_key(s["name"]) for s in settings]
+
+if len(set(normalised_keys)) != len(normalised_keys):
+    raise Exception("Setting keys must be unique when normalised")
+
+normalised_keys_array = "\n".join([f'    "{k}",' for k in normalised_keys])
+
+hash_seed, hash_bits, hash_displacements, hash_indices = perfect_hash(normalised_keys)
+
+hash_displacements = "\n".join([f"    {d}," for d in hash_displacements])
+
+hash_table = "\n".join([f"    Ximu3SettingsIndex{pascal_case(settings[i]['name'])}," if i >= 0 else "    -1," for i in hash_indices])
+
 types = "\n".join([f"    MetadataType{'String' if 'char name[' in s['declaration'] else title_case(s['declaration'].split()[0].replace('_t', ''))}," for s in settings])
 
 sizes = "\n".join([f"    sizeof (((Ximu3SettingsValues *) 0)->{camel_case(s['name'])})," for s in settings])
@@ -183,7 +241,13 @@ cases = "".join([template.replace("label", f"Ximu3SettingsIndex{pascal_case(s['n
 contents = f"""\
 {preamble}
 
+#include "Key.h"
 #include "Metadata.h"
+#include <string.h>
+
+#define HASH_SEED 0x{hash_seed:08X}
+
+#define HASH_BITS {hash_bits}
 
 static const char* const names[] = {{
 {names}
@@ -193,6 +257,18 @@ static const char* const keys[] = {{
 {keys}
 }};
 
+static const char* const normalisedKeys[] = {{
+{normalised_keys_array}
+}};
+
+static const uint32_t hashDisplacements[1 << HASH_BITS] = {{
+{hash_displacements}
+}};
+
+static const int hashTable[1 << HASH_BITS] = {{
+{hash_table}
+}};
+
 const MetadataType types[] = {{
 {types}
 }};
@@ -234,6 +310,21 @@ Metadata MetadataGet(Ximu3Settings * const settings, const Ximu3SettingsIndex in
     }};
     return metadata;
 }}
+
+Ximu3Result MetadataGetIndex(Ximu3SettingsIndex * const index, const char* const key) {{
+    char normalisedKey[XIMU3_KEY_SIZE];
+    if (KeyNormalise(normalisedKey, sizeof (normalisedKey), key) == false) {{
+        return Ximu3ResultError;
+    }}
+    const uint32_t hash = KeyHash(normalisedKey, HASH_SEED);
+    const uint32_t displacement = hashDisplacements[hash >> (32 - HASH_BITS)];
+    const int hashTableIndex = hashTable[((hash ^ displacement) * 0x9E3779B1) >> (32 - HASH_BITS)];
+    if ((hashTableIndex < 0) || (strcmp(normalisedKey, normalisedKeys[hashTableIndex]) != 0)) {{
+        return Ximu3ResultError;
+    }}
+    *index = hashTableIndex;
+    return Ximu3ResultOk;
+}}
 """
 
 with open("Metadata.c", "w") as file:
@@ -72,6 +72,7 @@ void UART2_RX_Handler (void);
 void UART2_TX_Handler (void);
 void CCT1_Handler (void);
 void CCT2_Handler (void);
+void I2C2_MASTER_Handler (void);
 
 
 // *****************************************************************************
@@ -104,6 +105,11 @@ void __attribute__((used)) __ISR(_CCT2_VECTOR, ipl1SOFT) CCT2_Handler (void)
     Cct2InterruptHandler();
 }
 
+void __attribute__((used)) __ISR(_I2C2_MASTER_VECTOR, ipl1SOFT) I2C2_MASTER_Handler (void)
+{
+    I2C2MasterInterruptHandler();
+}
+
 
 
 
@@ -62,6 +62,7 @@ void Uart2RxInterruptHandler(void);
 void Uart2TxInterruptHandler(void);
 void Cct1InterruptHandler(void);
 void Cct2InterruptHandler(void);
+void I2C2MasterInterruptHandler(void);
 
 
 #endif // INTERRUPTS_H
@@ -59,6 +59,7 @@ void EVIC_Initialize( void )
     IPC7SET = 0x400U | 0x0U;  /* USB:  Priority 1 / Subpriority 0 */
     IPC14SET = 0x4U | 0x0U;  /* UART2_RX:  Priority 1 / Subpriority 0 */
     IPC14SET = 0x400U | 0x0U;  /* UART2_TX:  Priority 1 / Subpriority 0 */
+    IPC17SET = 0x400U | 0x0U;  /* I2C2_MASTER:  Priority 1 / Subpriority 0 */
     IPC18SET = 0x1c000000U | 0x0U;  /* CCT1:  Priority 7 / Subpriority 0 */
     IPC19SET = 0x400U | 0x0U;  /* CCT2:  Priority 1 / Subpriority 0 */
 
@@ -14,9 +14,13 @@
 // Includes
 
 #include "definitions.h"
+#include "Filter/Filter.h"
+#include "I2C/I2C2.h"
 #include "Led/Led.h"
-#include "Periodic.h"
+#include "Profile/Profile.h"
 #include "ResetCause/ResetCause.h"
+#include "SampleLog/SampleLog.h"
+#include "Statistics/Statistics.h"
 #include <stdbool.h>
 #include <stddef.h>
 #include <stdio.h>
@@ -45,25 +49,43 @@ int main(void) {
     // Initialise modules
     TimerInitialise();
     LedInitialise();
-    ThermometerInitialise();
+    ThermometerInitialise(&thermometerSettingsDefault);
+    Ximu3DeviceInitialise();
 
     // Main program loop
+    StatisticsInitialise();
     while (true) {
+        StatisticsLoop();
+
+        PROFILE_START(ProfileRegionSysTasks);
         SYS_Tasks();
+        PROFILE_STOP(ProfileRegionSysTasks);
 
         // Module tasks
+        PROFILE_START(ProfileRegionI2C2Tasks);
+        I2C2Tasks();
+        PROFILE_STOP(ProfileRegionI2C2Tasks);
+        PROFILE_START(ProfileRegionUsbCdcTasks);
         UsbCdcTasks();
+        PROFILE_STOP(ProfileRegionUsbCdcTasks);
         Ximu3DeviceTasks();
 
         // Send temperature
-        if (PERIODIC_POLL(1.0f)) {
-            const Ximu3DataTemperature data = {
-                .timestamp = TimestampGet(),
-                .temperature = ThermometerReadTemperature(),
+        ThermometerData thermometerData;
+        PROFILE_START(ProfileRegionThermometerRead);
+        const bool newData = ThermometerRead(&thermometerData);
+        PROFILE_STOP(ProfileRegionThermometerRead);
+        int16_t raw;
+        if (newData && FilterUpdate(thermometerData.raw, &raw)) {
+            PROFILE_START(ProfileRegionSendTemperature);
+            const Ximu3DataTemperatureFixed data = {
+                .timestamp = TimestampFrom(thermometerData.ticks),
+                .temperature = raw,
             };
-            char message[256];
-            const int numberOfBytes = Ximu3DataTemperatureAscii(message, sizeof (message), &data);
-            UsbCdcWrite(message, numberOfBytes);
+            SampleLogWrite(data.timestamp, data.temperature);
+            Ximu3DeviceSendTemperature(&data);
+            StatisticsDeadline(StatisticsEventTemperatureOutput, thermometerData.ticks); // lateness is latency from data ready to output
+            PROFILE_STOP(ProfileRegionSendTemperature);
         }
     }
     return (EXIT_FAILURE);
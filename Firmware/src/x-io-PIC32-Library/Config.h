@@ -10,11 +10,17 @@
 //------------------------------------------------------------------------------
 // Definitions
 
+#define I2C2_TRANSFER_QUEUE_LENGTH          (8)
+#define I2C2_SCL_PIN                        (GPIO_PIN_RB3)
+#define I2C2_SDA_PIN                        (GPIO_PIN_RB2)
+
 #define UART2_READ_BUFFER_SIZE              (16)
 #define UART2_WRITE_BUFFER_SIZE             (4096)
 
 #define USB_CDC_READ_BUFFER_SIZE            (4096)
+#define USB_CDC_READ_TRANSFERS              (2)
 #define USB_CDC_WRITE_BUFFER_SIZE           (4096)
+#define USB_CDC_WRITE_TRANSFERS             (2)
 
 #endif
 
@@ -187,6 +187,40 @@ static inline __attribute__((always_inline)) FifoResult FifoWrite(Fifo * const f
     return FifoResultOk;
 }
 
+/**
+ * @brief Provides a pointer to the next contiguous block of space in the FIFO.
+ * FifoWritePointerComplete must be called after data has been written. If the
+ * space wraps around the end of the FIFO then the remaining space may be
+ * obtained by calling this function again after FifoWritePointerComplete.
+ * @param fifo FIFO structure.
+ * @param pointer Pointer.
+ * @param numberOfBytes Number of bytes.
+ */
+static inline __attribute__((always_inline)) void FifoWritePointer(Fifo * const fifo, volatile void* * const pointer, size_t * const numberOfBytes) {
+    *pointer = (void*) &fifo->data[fifo->writeIndex];
+    const size_t readIndex = fifo->readIndex; // avoid asynchronous hazard
+    if (fifo->writeIndex < readIndex) {
+        *numberOfBytes = readIndex - fifo->writeIndex - 1;
+    } else if (readIndex == 0) {
+        *numberOfBytes = fifo->dataSize - fifo->writeIndex - 1;
+    } else {
+        *numberOfBytes = fifo->dataSize - fifo->writeIndex;
+    }
+}
+
+/**
+ * @brief Updates the FIFO after FifoWritePointer.
+ * @param fifo FIFO structure.
+ * @param numberOfBytes Number of bytes.
+ */
+static inline __attribute__((always_inline)) void FifoWritePointerComplete(Fifo * const fifo, const size_t numberOfBytes) {
+    size_t writeIndex = fifo->writeIndex + numberOfBytes;
+    if (writeIndex >= fifo->dataSize) {
+        writeIndex = 0;
+    }
+    fifo->writeIndex = writeIndex; // update once to avoid asynchronous hazard
+}
+
 /**
  * @brief Writes a byte to the FIFO.
  * @param fifo FIFO structure.
@@ -11,6 +11,7 @@
 // Includes
 
 #include <stdbool.h>
+#include <stddef.h>
 #include <stdint.h>
 #include "Timer/Timer.h"
 
@@ -27,10 +28,35 @@ typedef enum {
 } I2CClockFrequency;
 
 /**
- * @brief Timeout in timer ticks. Equal to 10 clock cycles for the slowest clock
- * frequency.
+ * @brief Timeout of an event in timer ticks for a clock frequency. Equal to
+ * twice the 9 clock cycles of a byte and ACK/NACK, plus a margin for interrupt
+ * latency.
  */
-#define I2C_TIMEOUT (TIMER_TICKS_PER_SECOND / (I2CClockFrequency100kHz / 10))
+#define I2C_TIMEOUT(clockFrequency) (((2 * 9 * (uint64_t) TIMER_TICKS_PER_SECOND) / (clockFrequency)) + (100 * TIMER_TICKS_PER_MICROSECOND))
+
+/**
+ * @brief Transfer result.
+ */
+typedef enum {
+    I2CTransferResultOk,
+    I2CTransferResultNack,
+    I2CTransferResultTimeout,
+} I2CTransferResult;
+
+/**
+ * @brief Transfer. A write of numberOfWriteBytes is followed by a read of
+ * numberOfReadBytes using a repeated start. Either number of bytes may be zero.
+ * The structure must remain valid until the callback is called.
+ */
+typedef struct {
+    uint8_t address;
+    const uint8_t* writeData;
+    size_t numberOfWriteBytes;
+    uint8_t* readData;
+    size_t numberOfReadBytes;
+    void (*callback)(const I2CTransferResult result, void* const context); // NULL if unused
+    void* context;
+} I2CTransfer;
 
 /**
  * @brief I2C interface.
@@ -7,6 +7,7 @@
 //------------------------------------------------------------------------------
 // Includes
 
+#include "Config.h"
 #include "definitions.h"
 #include "I2C2.h"
 #include "Timer/Timer.h"
@@ -19,11 +20,42 @@
  */
 //#define PRINT_MESSAGES
 
+/**
+ * @brief Maximum number of clock cycles generated to recover the bus. A
+ * client holding SDA low will release it within 9 clock cycles.
+ */
+#define BUS_RECOVERY_CLOCK_CYCLES (9)
+
+/**
+ * @brief Transfer state. Each state is the event that the interrupt is
+ * waiting for.
+ */
+typedef enum {
+    StateIdle,
+    StateStart,
+    StateWriteAddress,
+    StateWriteData,
+    StateRepeatedStart,
+    StateReadAddress,
+    StateReceive,
+    StateAck,
+    StateStop,
+} State;
+
 //------------------------------------------------------------------------------
 // Function declarations
 
 static inline __attribute__((always_inline)) bool Send(const uint8_t byte);
 static void WaitForInterruptOrTimeout(void);
+static void WaitForTransfers(void);
+static void CheckTimeout(void);
+static void BusRecover(void);
+static void HalfClockCycleDelay(void);
+static void StartTransfer(void);
+static void TransferTasks(void);
+static void TransferWrite(void);
+static void TransferStop(const I2CTransferResult result);
+static void TransferComplete(void);
 
 //------------------------------------------------------------------------------
 // Variables
@@ -38,6 +70,17 @@ const I2C i2c2 = {
     .receive = I2C2Receive,
 };
 
+static I2CTransfer * volatile queue[I2C2_TRANSFER_QUEUE_LENGTH];
+static volatile int queueWriteIndex;
+static volatile int queueReadIndex;
+static volatile State state;
+static volatile bool blocking;
+static size_t transferIndex;
+static I2CTransferResult result;
+static volatile uint64_t transferTimeout;
+static uint64_t timeout;
+static uint32_t halfClockCycleTicks;
+
 //------------------------------------------------------------------------------
 // Functions
 
@@ -51,6 +94,8 @@ void I2C2Initialise(const I2CClockFrequency clockFrequency) {
     I2C2Deinitialise();
 
     // Configure I2C
+    timeout = I2C_TIMEOUT(clockFrequency);
+    halfClockCycleTicks = TIMER_TICKS_PER_SECOND / (2 * clockFrequency);
     I2C2BRG = I2CCalculateI2Cxbrg(clockFrequency);
     if (clockFrequency != I2CClockFrequency400kHz) {
         I2C2CONbits.DISSLW = 1; // slew rate control disabled
@@ -70,12 +115,66 @@ void I2C2Deinitialise(void) {
     // Disable interrupt
     EVIC_SourceDisable(INT_SOURCE_I2C2_MASTER);
     EVIC_SourceStatusClear(INT_SOURCE_I2C2_MASTER);
+
+    // Discard transfers
+    queueWriteIndex = 0;
+    queueReadIndex = 0;
+    state = StateIdle;
+    blocking = false;
+}
+
+/**
+ * @brief Module tasks. This function should be called repeatedly within the
+ * main program loop if transfers are used.
+ */
+void I2C2Tasks(void) {
+    CheckTimeout();
 }
 
 /**
- * @brief Generates a start event.
+ * @brief Queues a transfer. The transfer is performed by the interrupt and the
+ * callback is called from the interrupt on completion.
+ * @param transfer Transfer.
+ * @return True if the transfer was queued, false if the queue was full.
+ */
+bool I2C2Transfer(I2CTransfer * const transfer) {
+    const bool interruptState = EVIC_INT_SourceDisable(INT_SOURCE_I2C2_MASTER);
+
+    // Do nothing if queue full
+    const int nextIndex = (queueWriteIndex + 1) % I2C2_TRANSFER_QUEUE_LENGTH;
+    if (nextIndex == queueReadIndex) {
+        EVIC_INT_SourceRestore(INT_SOURCE_I2C2_MASTER, interruptState);
+        return false;
+    }
+
+    // Add to queue
+    queue[queueWriteIndex] = transfer;
+    queueWriteIndex = nextIndex;
+
+    // Start transfer if idle
+    if (state == StateIdle) {
+        StartTransfer();
+    } else {
+        EVIC_INT_SourceRestore(INT_SOURCE_I2C2_MASTER, interruptState);
+    }
+    return true;
+}
+
+/**
+ * @brief Returns true if a transfer is in progress or queued.
+ * @return True if a transfer is in progress or queued.
+ */
+bool I2C2TransferInProgress(void) {
+    return state != StateIdle;
+}
+
+/**
+ * @brief Generates a start event. Queued transfers will complete first.
  */
 void I2C2Start(void) {
+    WaitForTransfers();
+    blocking = true;
+    EVIC_SourceDisable(INT_SOURCE_I2C2_MASTER);
     EVIC_SourceStatusClear(INT_SOURCE_I2C2_MASTER);
     I2C2CONbits.SEN = 1;
     WaitForInterruptOrTimeout();
@@ -97,7 +196,7 @@ void I2C2RepeatedStart(void) {
 }
 
 /**
- * @brief Generates a stop event.
+ * @brief Generates a stop event. Queued transfers will resume.
  */
 void I2C2Stop(void) {
     EVIC_SourceStatusClear(INT_SOURCE_I2C2_MASTER);
@@ -106,6 +205,8 @@ void I2C2Stop(void) {
 #ifdef PRINT_MESSAGES
     I2CPrintStop();
 #endif
+    blocking = false;
+    StartTransfer();
 }
 
 /**
@@ -193,16 +294,214 @@ uint8_t I2C2Receive(const bool ack) {
  * @brief Waits for the interrupt or timeout.
  */
 static void WaitForInterruptOrTimeout(void) {
-    const uint64_t timeout = TimerGetTicks64() + I2C_TIMEOUT;
+    const uint64_t eventTimeout = TimerGetTicks64() + timeout;
     while (true) {
         if (EVIC_SourceStatusGet(INT_SOURCE_I2C2_MASTER)) {
             break;
         }
-        if (TimerGetTicks64() > timeout) {
+        if (TimerGetTicks64() > eventTimeout) {
             break;
         }
     }
 }
 
+/**
+ * @brief Waits for queued transfers to complete or timeout.
+ */
+static void WaitForTransfers(void) {
+    while (state != StateIdle) {
+        CheckTimeout();
+    }
+}
+
+/**
+ * @brief Aborts the transfer in progress if the current event has timed out.
+ * An event that has completed but not yet been serviced by the interrupt has
+ * not timed out. The bus is recovered before the next transfer is started.
+ */
+static void CheckTimeout(void) {
+    const bool interruptState = EVIC_INT_SourceDisable(INT_SOURCE_I2C2_MASTER);
+    if ((state == StateIdle) || (TimerGetTicks64() <= transferTimeout) || EVIC_SourceStatusGet(INT_SOURCE_I2C2_MASTER)) {
+        EVIC_INT_SourceRestore(INT_SOURCE_I2C2_MASTER, interruptState);
+        return;
+    }
+    I2C2CONbits.I2CEN = 0; // reset module to abandon event
+    BusRecover();
+    I2C2CONbits.I2CEN = 1;
+    result = I2CTransferResultTimeout;
+    TransferComplete();
+    EVIC_INT_SourceRestore(INT_SOURCE_I2C2_MASTER, state != StateIdle); // enabled only if next transfer started
+}
+
+/**
+ * @brief Recovers the bus from a client holding SDA low. SCL is clocked until
+ * SDA is released and then a stop is generated. The module must be disabled
+ * so that the pins are controlled by the port. The pins are open-drain and so
+ * are driven low as an output and released as an input.
+ */
+static void BusRecover(void) {
+    GPIO_PinClear(I2C2_SCL_PIN);
+    GPIO_PinClear(I2C2_SDA_PIN);
+    GPIO_PinInputEnable(I2C2_SDA_PIN);
+
+    // Clock SCL until SDA released
+    for (int clockCycle = 0; (clockCycle < BUS_RECOVERY_CLOCK_CYCLES) && (GPIO_PinRead(I2C2_SDA_PIN) == false); clockCycle++) {
+        GPIO_PinOutputEnable(I2C2_SCL_PIN);
+        HalfClockCycleDelay();
+        GPIO_PinInputEnable(I2C2_SCL_PIN);
+        HalfClockCycleDelay();
+    }
+
+    // Stop
+    GPIO_PinOutputEnable(I2C2_SCL_PIN);
+    GPIO_PinOutputEnable(I2C2_SDA_PIN);
+    HalfClockCycleDelay();
+    GPIO_PinInputEnable(I2C2_SCL_PIN);
+    HalfClockCycleDelay();
+    GPIO_PinInputEnable(I2C2_SDA_PIN);
+    HalfClockCycleDelay();
+}
+
+/**
+ * @brief Blocking delay of half a clock cycle.
+ */
+static void HalfClockCycleDelay(void) {
+    const uint32_t start = TimerGetTicks32();
+    while ((TimerGetTicks32() - start) < halfClockCycleTicks);
+}
+
+/**
+ * @brief Starts the next queued transfer. The interrupt must be disabled or in
+ * progress when this function is called. The interrupt will be enabled if a
+ * transfer is started, and disabled otherwise.
+ */
+static void StartTransfer(void) {
+    if (blocking || (queueReadIndex == queueWriteIndex)) {
+        state = StateIdle;
+        EVIC_SourceDisable(INT_SOURCE_I2C2_MASTER);
+        return;
+    }
+    transferIndex = 0;
+    result = I2CTransferResultOk;
+    transferTimeout = TimerGetTicks64() + timeout;
+    EVIC_SourceStatusClear(INT_SOURCE_I2C2_MASTER);
+    state = StateStart;
+    I2C2CONbits.SEN = 1;
+    EVIC_SourceEnable(INT_SOURCE_I2C2_MASTER);
+}
+
+/**
+ * @brief I2C master interrupt handler. This function should be called by the
+ * ISR implementation generated by MPLAB Harmony.
+ */
+void I2C2MasterInterruptHandler(void) {
+    EVIC_SourceStatusClear(INT_SOURCE_I2C2_MASTER);
+    transferTimeout = TimerGetTicks64() + timeout;
+    TransferTasks();
+}
+
+/**
+ * @brief Transfer tasks. Advances the transfer state on completion of each
+ * event.
+ */
+static void TransferTasks(void) {
+    const I2CTransfer * const transfer = queue[queueReadIndex];
+    switch (state) {
+        case StateIdle:
+            break;
+        case StateStart:
+            if (transfer->numberOfWriteBytes > 0) {
+                state = StateWriteAddress;
+                I2C2TRN = I2CAddressWrite(transfer->address);
+            } else {
+                state = StateReadAddress;
+                I2C2TRN = I2CAddressRead(transfer->address);
+            }
+            break;
+        case StateWriteAddress:
+        case StateWriteData:
+            if (I2C2STATbits.ACKSTAT == 1) {
+                TransferStop(I2CTransferResultNack);
+                break;
+            }
+            TransferWrite();
+            break;
+        case StateRepeatedStart:
+            state = StateReadAddress;
+            I2C2TRN = I2CAddressRead(transfer->address);
+            break;
+        case StateReadAddress:
+            if (I2C2STATbits.ACKSTAT == 1) {
+                TransferStop(I2CTransferResultNack);
+                break;
+            }
+            transferIndex = 0;
+            state = StateReceive;
+            I2C2CONbits.RCEN = 1;
+            break;
+        case StateReceive:
+            transfer->readData[transferIndex++] = I2C2RCV;
+            state = StateAck;
+            I2C2CONbits.ACKDT = transferIndex < transfer->numberOfReadBytes ? 0 : 1;
+            I2C2CONbits.ACKEN = 1;
+            break;
+        case StateAck:
+            if (transferIndex < transfer->numberOfReadBytes) {
+                state = StateReceive;
+                I2C2CONbits.RCEN = 1;
+                break;
+            }
+            TransferStop(I2CTransferResultOk);
+            break;
+        case StateStop:
+            TransferComplete();
+            break;
+    }
+}
+
+/**
+ * @brief Writes the next byte or continues to the read or stop.
+ */
+static void TransferWrite(void) {
+    const I2CTransfer * const transfer = queue[queueReadIndex];
+    if (transferIndex < transfer->numberOfWriteBytes) {
+        state = StateWriteData;
+        I2C2TRN = transfer->writeData[transferIndex++];
+        return;
+    }
+    if (transfer->numberOfReadBytes > 0) {
+        state = StateRepeatedStart;
+        I2C2CONbits.RSEN = 1;
+        return;
+    }
+    TransferStop(I2CTransferResultOk);
+}
+
+/**
+ * @brief Generates a stop event to end the transfer.
+ * @param result_ Result.
+ */
+static void TransferStop(const I2CTransferResult result_) {
+    result = result_;
+    state = StateStop;
+    I2C2CONbits.PEN = 1;
+}
+
+/**
+ * @brief Removes the transfer from the queue, calls the callback, and starts
+ * the next transfer.
+ */
+static void TransferComplete(void) {
+    const I2CTransfer * const transfer = queue[queueReadIndex];
+    queueReadIndex = (queueReadIndex + 1) % I2C2_TRANSFER_QUEUE_LENGTH;
+    state = StateIdle;
+    if (transfer->callback != NULL) {
+        transfer->callback(result, transfer->context);
+    }
+    if (state == StateIdle) { // callback may have started a transfer
+        StartTransfer();
+    }
+}
+
 //------------------------------------------------------------------------------
 // End of file
@@ -24,6 +24,9 @@ extern const I2C i2c2;
 
 void I2C2Initialise(const I2CClockFrequency clockFrequency);
 void I2C2Deinitialise(void);
+void I2C2Tasks(void);
+bool I2C2Transfer(I2CTransfer * const transfer);
+bool I2C2TransferInProgress(void);
 void I2C2Start(void);
 void I2C2RepeatedStart(void);
 void I2C2Stop(void);
@@ -31,6 +34,7 @@ bool I2C2Send(const uint8_t byte);
 bool I2C2SendAddressRead(const uint8_t address);
 bool I2C2SendAddressWrite(const uint8_t address);
 uint8_t I2C2Receive(const bool ack);
+void I2C2MasterInterruptHandler(void);
 
 #endif
 
@@ -0,0 +1,247 @@
+/**
+ * @file MaskedFifo.h
+ * @author Seb Madgwick
+ * @brief Asynchronous FIFO buffer with a power-of-two size. The read and write
+ * indices are free-running and masked on access so that the byte functions do
+ * not need to handle wraparound.
+ */
+
+#ifndef MASKED_FIFO_H
+#define MASKED_FIFO_H
+
+//------------------------------------------------------------------------------
+// Includes
+
+#include "Fifo.h"
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+//------------------------------------------------------------------------------
+// Definitions
+
+/**
+ * @brief Compile-time assertion that the size of a data array is a power of
+ * two.
+ * @param data Data array.
+ */
+#define MASKED_FIFO_ASSERT_SIZE(data) _Static_assert((sizeof (data) & (sizeof (data) - 1)) == 0, #data " size must be a power of two")
+
+/**
+ * @brief FIFO structure. All structure members are private except for
+ * initialisation. The data size must be a power of two.
+ *
+ * Example:
+ * @code
+ * uint8_t data[1024];
+ * MASKED_FIFO_ASSERT_SIZE(data);
+ * MaskedFifo fifo = {.data = data, .mask = sizeof (data) - 1};
+ * @endcode
+ */
+typedef struct {
+    volatile uint8_t * const data;
+    const size_t mask;
+    volatile size_t writeIndex;
+    volatile size_t readIndex;
+} MaskedFifo;
+
+//------------------------------------------------------------------------------
+// Inline functions
+
+/**
+ * @brief Returns the capacity of the FIFO.
+ * @param fifo FIFO structure.
+ * @return Capacity of the FIFO.
+ */
+static inline __attribute__((always_inline)) size_t MaskedFifoCapacity(MaskedFifo * const fifo) {
+    return fifo->mask + 1;
+}
+
+/**
+ * @brief Returns the number of bytes available to read from the FIFO.
+ * @param fifo FIFO structure.
+ * @return Number of bytes available in the buffer.
+ */
+static inline __attribute__((always_inline)) size_t MaskedFifoAvailableRead(MaskedFifo * const fifo) {
+    return fifo->writeIndex - fifo->readIndex;
+}
+
+/**
+ * @brief Provides a pointer to the next contiguous block of data in the FIFO.
+ * MaskedFifoReadPointerComplete must be called after data has been read.
+ * @param fifo FIFO structure.
+ * @param pointer Pointer.
+ * @param numberOfBytes Number of bytes.
+ */
+static inline __attribute__((always_inline)) void MaskedFifoReadPointer(MaskedFifo * const fifo, volatile void* * const pointer, size_t * const numberOfBytes) {
+    const size_t offset = fifo->readIndex & fifo->mask;
+    *pointer = (void*) &fifo->data[offset];
+    const size_t bytesAvailable = MaskedFifoAvailableRead(fifo);
+    const size_t bytesBeforeWraparound = MaskedFifoCapacity(fifo) - offset;
+    *numberOfBytes = bytesAvailable < bytesBeforeWraparound ? bytesAvailable : bytesBeforeWraparound;
+}
+
+/**
+ * @brief Provides a pointer to the next contiguous block of data in the FIFO
+ * after the specified number of bytes. The data remains in the FIFO until
+ * MaskedFifoReadPointerComplete is called for all preceding bytes. This allows
+ * several blocks to be in use at the same time.
+ * @param fifo FIFO structure.
+ * @param offset Number of bytes to skip. Must not exceed the number of bytes
+ * available.
+ * @param pointer Pointer.
+ * @param numberOfBytes Number of bytes.
+ */
+static inline __attribute__((always_inline)) void MaskedFifoPeekPointer(MaskedFifo * const fifo, const size_t offset, volatile void* * const pointer, size_t * const numberOfBytes) {
+    const size_t index = (fifo->readIndex + offset) & fifo->mask;
+    *pointer = (void*) &fifo->data[index];
+    const size_t bytesAvailable = MaskedFifoAvailableRead(fifo) - offset;
+    const size_t bytesBeforeWraparound = MaskedFifoCapacity(fifo) - index;
+    *numberOfBytes = bytesAvailable < bytesBeforeWraparound ? bytesAvailable : bytesBeforeWraparound;
+}
+
+/**
+ * @brief Updates the FIFO after MaskedFifoReadPointer or MaskedFifoPeekPointer.
+ * @param fifo FIFO structure.
+ * @param numberOfBytes Number of bytes.
+ */
+static inline __attribute__((always_inline)) void MaskedFifoReadPointerComplete(MaskedFifo * const fifo, const size_t numberOfBytes) {
+    fifo->readIndex += numberOfBytes;
+}
+
+/**
+ * @brief Reads data from the FIFO.
+ * @param fifo FIFO structure.
+ * @param destination Destination.
+ * @param numberOfBytes Number of bytes.
+ * @return Number of bytes read.
+ */
+static inline __attribute__((always_inline)) size_t MaskedFifoRead(MaskedFifo * const fifo, void* const destination, size_t numberOfBytes) {
+
+    // Limit number of bytes to number available
+    const size_t bytesAvailable = MaskedFifoAvailableRead(fifo);
+    if (numberOfBytes > bytesAvailable) {
+        numberOfBytes = bytesAvailable;
+    }
+
+    // Read data
+    const size_t offset = fifo->readIndex & fifo->mask;
+    const size_t bytesBeforeWraparound = MaskedFifoCapacity(fifo) - offset;
+    if (numberOfBytes > bytesBeforeWraparound) {
+        memcpy(destination, (void*) &fifo->data[offset], bytesBeforeWraparound);
+        memcpy(&((uint8_t*) destination)[bytesBeforeWraparound], (void*) fifo->data, numberOfBytes - bytesBeforeWraparound);
+    } else {
+        memcpy(destination, (void*) &fifo->data[offset], numberOfBytes);
+    }
+    fifo->readIndex += numberOfBytes;
+    return numberOfBytes;
+}
+
+/**
+ * @brief Reads a byte from the FIFO. This function must only be called if
+ * there are bytes available to read.
+ * @param fifo FIFO structure.
+ * @return Byte.
+ */
+static inline __attribute__((always_inline)) uint8_t MaskedFifoReadByte(MaskedFifo * const fifo) {
+    const size_t readIndex = fifo->readIndex;
+    const uint8_t byte = fifo->data[readIndex & fifo->mask];
+    fifo->readIndex = readIndex + 1;
+    return byte;
+}
+
+/**
+ * @brief Returns the space available to write to the FIFO.
+ * @param fifo FIFO structure.
+ * @return Space available in the buffer.
+ */
+static inline __attribute__((always_inline)) size_t MaskedFifoAvailableWrite(MaskedFifo * const fifo) {
+    return MaskedFifoCapacity(fifo) - (fifo->writeIndex - fifo->readIndex);
+}
+
+/**
+ * @brief Writes data to the FIFO.
+ * @param fifo FIFO structure.
+ * @param data Data.
+ * @param numberOfBytes Number of bytes.
+ * @return Result.
+ */
+static inline __attribute__((always_inline)) FifoResult MaskedFifoWrite(MaskedFifo * const fifo, const void* const data, const size_t numberOfBytes) {
+
+    // Do nothing if not enough space available
+    if (numberOfBytes > MaskedFifoAvailableWrite(fifo)) {
+        return FifoResultError;
+    }
+
+    // Write data
+    const size_t offset = fifo->writeIndex & fifo->mask;
+    const size_t bytesBeforeWraparound = MaskedFifoCapacity(fifo) - offset;
+    if (numberOfBytes > bytesBeforeWraparound) {
+        memcpy((void*) &fifo->data[offset], data, bytesBeforeWraparound);
+        memcpy((void*) fifo->data, &((uint8_t*) data)[bytesBeforeWraparound], numberOfBytes - bytesBeforeWraparound);
+    } else {
+        memcpy((void*) &fifo->data[offset], data, numberOfBytes);
+    }
+    fifo->writeIndex += numberOfBytes;
+    return FifoResultOk;
+}
+
+/**
+ * @brief Provides a pointer to the next contiguous block of space in the FIFO.
+ * MaskedFifoWritePointerComplete must be called after data has been written.
+ * If the space wraps around the end of the FIFO then the remaining space may
+ * be obtained by calling this function again after
+ * MaskedFifoWritePointerComplete.
+ * @param fifo FIFO structure.
+ * @param pointer Pointer.
+ * @param numberOfBytes Number of bytes.
+ */
+static inline __attribute__((always_inline)) void MaskedFifoWritePointer(MaskedFifo * const fifo, volatile void* * const pointer, size_t * const numberOfBytes) {
+    const size_t offset = fifo->writeIndex & fifo->mask;
+    *pointer = (void*) &fifo->data[offset];
+    const size_t spaceAvailable = MaskedFifoAvailableWrite(fifo);
+    const size_t bytesBeforeWraparound = MaskedFifoCapacity(fifo) - offset;
+    *numberOfBytes = spaceAvailable < bytesBeforeWraparound ? spaceAvailable : bytesBeforeWraparound;
+}
+
+/**
+ * @brief Updates the FIFO after MaskedFifoWritePointer.
+ * @param fifo FIFO structure.
+ * @param numberOfBytes Number of bytes.
+ */
+static inline __attribute__((always_inline)) void MaskedFifoWritePointerComplete(MaskedFifo * const fifo, const size_t numberOfBytes) {
+    fifo->writeIndex += numberOfBytes;
+}
+
+/**
+ * @brief Writes a byte to the FIFO.
+ * @param fifo FIFO structure.
+ * @param byte Byte.
+ * @return Result.
+ */
+static inline __attribute__((always_inline)) FifoResult MaskedFifoWriteByte(MaskedFifo * const fifo, const uint8_t byte) {
+
+    // Do nothing if not enough space available
+    const size_t writeIndex = fifo->writeIndex;
+    if ((writeIndex - fifo->readIndex) > fifo->mask) {
+        return FifoResultError;
+    }
+
+    // Write byte
+    fifo->data[writeIndex & fifo->mask] = byte;
+    fifo->writeIndex = writeIndex + 1;
+    return FifoResultOk;
+}
+
+/**
+ * @brief Clears the FIFO.
+ * @param fifo FIFO structure.
+ */
+static inline __attribute__((always_inline)) void MaskedFifoClear(MaskedFifo * const fifo) {
+    fifo->readIndex = fifo->writeIndex;
+}
+
+#endif
+
+//------------------------------------------------------------------------------
+// End of file
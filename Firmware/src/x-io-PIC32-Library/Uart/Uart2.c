@@ -9,6 +9,7 @@
 
 #include "Config.h"
 #include "definitions.h"
+#include "MaskedFifo.h"
 #include "Uart2.h"
 
 //------------------------------------------------------------------------------
@@ -22,9 +23,11 @@ static inline __attribute__((always_inline)) void TxInterruptTasks(void);
 
 static bool receiveBufferOverrun;
 static uint8_t readData[UART2_READ_BUFFER_SIZE];
-static Fifo readFifo = {.data = readData, .dataSize = sizeof (readData)};
+MASKED_FIFO_ASSERT_SIZE(readData);
+static MaskedFifo readFifo = {.data = readData, .mask = sizeof (readData) - 1};
 static uint8_t writeData[UART2_WRITE_BUFFER_SIZE];
-static Fifo writeFifo = {.data = writeData, .dataSize = sizeof (writeData)};
+MASKED_FIFO_ASSERT_SIZE(writeData);
+static MaskedFifo writeFifo = {.data = writeData, .mask = sizeof (writeData) - 1};
 
 //------------------------------------------------------------------------------
 // Functions
@@ -99,7 +102,7 @@ size_t Uart2AvailableRead(void) {
     }
 
     // Return number of bytes
-    return FifoAvailableRead(&readFifo);
+    return MaskedFifoAvailableRead(&readFifo);
 }
 
 /**
@@ -110,7 +113,7 @@ size_t Uart2AvailableRead(void) {
  */
 size_t Uart2Read(void* const destination, size_t numberOfBytes) {
     Uart2AvailableRead(); // process hardware receive buffer
-    return FifoRead(&readFifo, destination, numberOfBytes);
+    return MaskedFifoRead(&readFifo, destination, numberOfBytes);
 }
 
 /**
@@ -119,7 +122,7 @@ size_t Uart2Read(void* const destination, size_t numberOfBytes) {
  * @return Byte.
  */
 uint8_t Uart2ReadByte(void) {
-    return FifoReadByte(&readFifo);
+    return MaskedFifoReadByte(&readFifo);
 }
 
 /**
@@ -127,7 +130,7 @@ uint8_t Uart2ReadByte(void) {
  * @return Space available in the write buffer.
  */
 size_t Uart2AvailableWrite(void) {
-    return FifoAvailableWrite(&writeFifo);
+    return MaskedFifoAvailableWrite(&writeFifo);
 }
 
 /**
@@ -137,7 +140,7 @@ size_t Uart2AvailableWrite(void) {
  * @return Result.
  */
 FifoResult Uart2Write(const void* const data, const size_t numberOfBytes) {
-    const FifoResult result = FifoWrite(&writeFifo, data, numberOfBytes);
+    const FifoResult result = MaskedFifoWrite(&writeFifo, data, numberOfBytes);
     EVIC_SourceEnable(INT_SOURCE_UART2_TX);
     return result;
 }
@@ -148,7 +151,7 @@ FifoResult Uart2Write(const void* const data, const size_t numberOfBytes) {
  * @return Result.
  */
 FifoResult Uart2WriteByte(const uint8_t byte) {
-    const FifoResult result = FifoWriteByte(&writeFifo, byte);
+    const FifoResult result = MaskedFifoWriteByte(&writeFifo, byte);
     EVIC_SourceEnable(INT_SOURCE_UART2_TX);
     return result;
 }
@@ -157,7 +160,7 @@ FifoResult Uart2WriteByte(const uint8_t byte) {
  * @brief Clears the read buffer and resets the read buffer overrun flag.
  */
 void Uart2ClearReadBuffer(void) {
-    FifoClear(&readFifo);
+    MaskedFifoClear(&readFifo);
     Uart2ReceiveBufferOverrun();
 }
 
@@ -165,7 +168,7 @@ void Uart2ClearReadBuffer(void) {
  * @brief Clears the write buffer.
  */
 void Uart2ClearWriteBuffer(void) {
-    FifoClear(&writeFifo);
+    MaskedFifoClear(&writeFifo);
 }
 
 /**
@@ -236,11 +239,11 @@ void Uart2TxInterruptHandler(void) {
  */
 static inline __attribute__((always_inline)) void RxInterruptTasks(void) {
     while (U2STAbits.URXDA == 1) { // while data available in receive buffer
-        if (FifoAvailableWrite(&readFifo) == 0) { // if read buffer full
+        if (MaskedFifoAvailableWrite(&readFifo) == 0) { // if read buffer full
             EVIC_SourceDisable(INT_SOURCE_UART2_RX);
             break;
         } else {
-            FifoWriteByte(&readFifo, U2RXREG);
+            MaskedFifoWriteByte(&readFifo, U2RXREG);
         }
     }
     EVIC_SourceStatusClear(INT_SOURCE_UART2_RX);
@@ -253,10 +256,10 @@ static inline __attribute__((always_inline)) void TxInterruptTasks(void) {
     EVIC_SourceDisable(INT_SOURCE_UART2_TX); // disable TX interrupt to avoid nested interrupt
     EVIC_SourceStatusClear(INT_SOURCE_UART2_TX);
     while (U2STAbits.UTXBF == 0) { // while transmit buffer not full
-        if (FifoAvailableRead(&writeFifo) == 0) { // if write buffer empty
+        if (MaskedFifoAvailableRead(&writeFifo) == 0) { // if write buffer empty
             return;
         }
-        U2TXREG = FifoReadByte(&writeFifo);
+        U2TXREG = MaskedFifoReadByte(&writeFifo);
     }
     EVIC_SourceEnable(INT_SOURCE_UART2_TX); // re-enable TX interrupt
 }
@@ -9,15 +9,32 @@
 
 #include "Config.h"
 #include "definitions.h"
+#include "MaskedFifo.h"
 #include "UsbCdc.h"
 
+//------------------------------------------------------------------------------
+// Definitions
+
+#if (USB_CDC_READ_TRANSFERS + USB_CDC_WRITE_TRANSFERS + 1) > USB_DEVICE_CDC_QUEUE_DEPTH_COMBINED
+#error "USB_DEVICE_CDC_QUEUE_DEPTH_COMBINED must allow for all read and write transfers and one serial state notification"
+#endif
+
+/**
+ * @brief Read transfer size. Must be a multiple of the endpoint size.
+ */
+#define READ_TRANSFER_SIZE (512)
+
 //------------------------------------------------------------------------------
 // Function declarations
 
 static void APP_USBDeviceEventHandler(USB_DEVICE_EVENT event, void * eventData, uintptr_t context);
 static void APP_USBDeviceCDCEventHandler(USB_DEVICE_CDC_INDEX instanceIndex, USB_DEVICE_CDC_EVENT event, void* pData, uintptr_t context);
 static void ReadTasks(void);
+static void ReadSchedule(void);
+static void ReadComplete(const USB_DEVICE_CDC_EVENT_DATA_READ_COMPLETE * const readComplete);
 static void WriteTasks(void);
+static void WriteComplete(void);
+static void TransfersAborted(void);
 
 //------------------------------------------------------------------------------
 // Variables
@@ -25,13 +42,20 @@ static void WriteTasks(void);
 static volatile USB_DEVICE_HANDLE usbDeviceHandle = USB_DEVICE_HANDLE_INVALID;
 static volatile bool hostConnected;
 static volatile bool portOpen;
-static volatile uint8_t __attribute__((coherent)) readRequestData[512]; // must be declared __attribute__((coherent)) for PIC32MZ devices
-static volatile bool readInProgress;
-static volatile bool writeInProgress;
+static volatile uint8_t __attribute__((coherent)) readTransferData[USB_CDC_READ_TRANSFERS][READ_TRANSFER_SIZE]; // must be declared __attribute__((coherent)) for PIC32MZ devices
+static volatile int readTransferOldest;
+static volatile int readTransferCount;
+static volatile uint32_t readBufferOverflow;
+static volatile size_t writeTransferSizes[USB_CDC_WRITE_TRANSFERS];
+static volatile int writeTransferOldest;
+static volatile int writeTransferCount;
+static volatile size_t writeBytesInProgress;
 static uint8_t readData[USB_CDC_READ_BUFFER_SIZE];
-static Fifo readFifo = {.data = readData, .dataSize = sizeof (readData)};
-static uint8_t writeData[USB_CDC_WRITE_BUFFER_SIZE];
-static Fifo writeFifo = {.data = writeData, .dataSize = sizeof (writeData)};
+MASKED_FIFO_ASSERT_SIZE(readData);
+static MaskedFifo readFifo = {.data = readData, .mask = sizeof (readData) - 1};
+static uint8_t __attribute__((coherent)) writeData[USB_CDC_WRITE_BUFFER_SIZE]; // must be declared __attribute__((coherent)) for PIC32MZ devices
+MASKED_FIFO_ASSERT_SIZE(writeData);
+static MaskedFifo writeFifo = {.data = writeData, .mask = sizeof (writeData) - 1};
 
 //------------------------------------------------------------------------------
 // Functions
@@ -63,13 +87,13 @@ void UsbCdcTasks(void) {
 static void APP_USBDeviceEventHandler(USB_DEVICE_EVENT event, void * eventData, uintptr_t context) {
     switch (event) {
         case USB_DEVICE_EVENT_RESET:
-        case USB_DEVICE_EVENT_SUSPENDED:
         case USB_DEVICE_EVENT_DECONFIGURED:
             hostConnected = false;
             portOpen = false;
-            readInProgress = false;
-            writeInProgress = false;
+            TransfersAborted();
             break;
+        case USB_DEVICE_EVENT_SUSPENDED:
+            break; // transfers in progress resume when the bus resumes
         case USB_DEVICE_EVENT_CONFIGURED:
             if (((USB_DEVICE_EVENT_DATA_CONFIGURED *) eventData)->configurationValue == 1) {
                 USB_DEVICE_CDC_EventHandlerSet(USB_DEVICE_CDC_INDEX_0, APP_USBDeviceCDCEventHandler, (uintptr_t) NULL);
@@ -83,9 +107,7 @@ static void APP_USBDeviceEventHandler(USB_DEVICE_EVENT event, void * eventData,
             USB_DEVICE_Detach(usbDeviceHandle);
             hostConnected = false;
             portOpen = false;
-            readInProgress = false;
-            writeInProgress = false;
-            break;
+            break; // transfers in progress are aborted by the reset when the host reconnects
         default:
             break;
     }
@@ -116,17 +138,13 @@ static void APP_USBDeviceCDCEventHandler(USB_DEVICE_CDC_INDEX index, USB_DEVICE_
             USB_DEVICE_ControlStatus(usbDeviceHandle, USB_DEVICE_CONTROL_STATUS_OK);
             break;
         case USB_DEVICE_CDC_EVENT_READ_COMPLETE:
-            if (readInProgress) { // prevent unexpected read event for PIC32MZ devices when host reconnected
-                const size_t numberOfBytes = ((USB_DEVICE_CDC_EVENT_DATA_READ_COMPLETE*) pData)->length;
-                FifoWrite(&readFifo, (void*) readRequestData, numberOfBytes);
-                readInProgress = false;
-            }
+            ReadComplete((USB_DEVICE_CDC_EVENT_DATA_READ_COMPLETE*) pData);
             break;
         case USB_DEVICE_CDC_EVENT_CONTROL_TRANSFER_DATA_RECEIVED:
             USB_DEVICE_ControlStatus(usbDeviceHandle, USB_DEVICE_CONTROL_STATUS_OK);
             break;
         case USB_DEVICE_CDC_EVENT_WRITE_COMPLETE:
-            writeInProgress = false;
+            WriteComplete();
             break;
         default:
             break;
@@ -134,52 +152,123 @@ static void APP_USBDeviceCDCEventHandler(USB_DEVICE_CDC_INDEX index, USB_DEVICE_
 }
 
 /**
- * @brief Read tasks.
+ * @brief Read tasks. Reads are normally rescheduled by the CDC event handler.
+ * This function schedules reads after the host is connected or after the read
+ * buffer was too full to reschedule.
  */
 static void ReadTasks(void) {
+    const bool state = EVIC_INT_SourceDisable(INT_SOURCE_USB);
+    ReadSchedule();
+    EVIC_INT_SourceRestore(INT_SOURCE_USB, state);
+}
 
-    // Do nothing if read in progress
-    if (readInProgress) {
-        return;
+/**
+ * @brief Schedules up to USB_CDC_READ_TRANSFERS reads. A read is only
+ * scheduled if there is space in the read buffer for the data of all reads in
+ * progress so that the host is held off instead of data being discarded.
+ */
+static void ReadSchedule(void) {
+    while (readTransferCount < USB_CDC_READ_TRANSFERS) {
+        if (MaskedFifoAvailableWrite(&readFifo) < ((readTransferCount + 1) * READ_TRANSFER_SIZE)) {
+            break;
+        }
+        USB_DEVICE_CDC_TRANSFER_HANDLE usbDeviceCdcTransferHandle = USB_DEVICE_CDC_TRANSFER_HANDLE_INVALID;
+        const USB_DEVICE_CDC_RESULT usbDeviceCdcResult = USB_DEVICE_CDC_Read(USB_DEVICE_CDC_INDEX_0, &usbDeviceCdcTransferHandle, (void*) readTransferData[(readTransferOldest + readTransferCount) % USB_CDC_READ_TRANSFERS], READ_TRANSFER_SIZE);
+        if (usbDeviceCdcResult != USB_DEVICE_CDC_RESULT_OK) {
+            break;
+        }
+        readTransferCount++;
+    }
+}
+
+/**
+ * @brief Copies the data of the oldest read to the read buffer and reschedules
+ * the read. This function must only be called from the CDC event handler.
+ * @param readComplete Read complete event data.
+ */
+static void ReadComplete(const USB_DEVICE_CDC_EVENT_DATA_READ_COMPLETE * const readComplete) {
+    if (readTransferCount == 0) {
+        return; // prevent unexpected read event for PIC32MZ devices when host reconnected
     }
 
-    // Schedule read
-    readInProgress = true;
-    static USB_DEVICE_CDC_TRANSFER_HANDLE usbDeviceCdcTransferHandle = USB_DEVICE_CDC_TRANSFER_HANDLE_INVALID;
-    const USB_DEVICE_CDC_RESULT usbDeviceCdcResult = USB_DEVICE_CDC_Read(USB_DEVICE_CDC_INDEX_0, &usbDeviceCdcTransferHandle, (void*) readRequestData, sizeof (readRequestData));
-    if (usbDeviceCdcResult != USB_DEVICE_CDC_RESULT_OK) {
-        readInProgress = false;
-        return;
+    // Copy data to read buffer
+    size_t numberOfBytes = readComplete->length;
+    const size_t spaceAvailable = MaskedFifoAvailableWrite(&readFifo);
+    if (numberOfBytes > spaceAvailable) {
+        readBufferOverflow += numberOfBytes - spaceAvailable;
+        numberOfBytes = spaceAvailable;
+    }
+    MaskedFifoWrite(&readFifo, (void*) readTransferData[readTransferOldest], numberOfBytes);
+    readTransferOldest = (readTransferOldest + 1) % USB_CDC_READ_TRANSFERS;
+    readTransferCount--;
+
+    // Reschedule read
+    if (readComplete->status == USB_DEVICE_CDC_RESULT_OK) {
+        ReadSchedule();
     }
 }
 
 /**
- * @brief Write tasks.
+ * @brief Write tasks. Contiguous blocks of the write buffer are written
+ * directly, without an intermediate copy, and up to USB_CDC_WRITE_TRANSFERS
+ * transfers are scheduled at a time so that the endpoint is not idle while
+ * data is waiting. The data remains in the write buffer until the transfer is
+ * complete.
  */
 static void WriteTasks(void) {
+    const bool state = EVIC_INT_SourceDisable(INT_SOURCE_USB);
+    while (writeTransferCount < USB_CDC_WRITE_TRANSFERS) {
 
-    // Do nothing if write in progress
-    if (writeInProgress) {
-        return;
-    }
+        // Do nothing if no data available
+        volatile void* data;
+        size_t numberOfBytes;
+        MaskedFifoPeekPointer(&writeFifo, writeBytesInProgress, &data, &numberOfBytes);
+        if (numberOfBytes == 0) {
+            break;
+        }
 
-    // Do nothing if no data available
-    if (FifoAvailableRead(&writeFifo) == 0) {
-        return;
+        // Schedule write
+        USB_DEVICE_CDC_TRANSFER_HANDLE usbDeviceCdcTransferHandle = USB_DEVICE_CDC_TRANSFER_HANDLE_INVALID;
+        const USB_DEVICE_CDC_RESULT usbDeviceCdcResult = USB_DEVICE_CDC_Write(USB_DEVICE_CDC_INDEX_0, &usbDeviceCdcTransferHandle, (void*) data, numberOfBytes, USB_DEVICE_CDC_TRANSFER_FLAGS_DATA_COMPLETE);
+        if (usbDeviceCdcResult != USB_DEVICE_CDC_RESULT_OK) {
+            break;
+        }
+        writeTransferSizes[(writeTransferOldest + writeTransferCount) % USB_CDC_WRITE_TRANSFERS] = numberOfBytes;
+        writeTransferCount++;
+        writeBytesInProgress += numberOfBytes;
     }
+    EVIC_INT_SourceRestore(INT_SOURCE_USB, state);
+}
 
-    // Copy data to buffer
-    static uint8_t __attribute__((coherent)) buffer[1024]; // must be declared __attribute__((coherent)) for PIC32MZ devices
-    const size_t numberOfBytes = FifoRead(&writeFifo, buffer, sizeof (buffer));
-
-    // Schedule write
-    writeInProgress = true;
-    static USB_DEVICE_CDC_TRANSFER_HANDLE usbDeviceCdcTransferHandle = USB_DEVICE_CDC_TRANSFER_HANDLE_INVALID;
-    const USB_DEVICE_CDC_RESULT usbDeviceCdcResult = USB_DEVICE_CDC_Write(USB_DEVICE_CDC_INDEX_0, &usbDeviceCdcTransferHandle, buffer, numberOfBytes, USB_DEVICE_CDC_TRANSFER_FLAGS_DATA_COMPLETE);
-    if (usbDeviceCdcResult != USB_DEVICE_CDC_RESULT_OK) {
-        writeInProgress = false;
-        return;
+/**
+ * @brief Removes the data of the oldest transfer from the write buffer. This
+ * function must only be called from the CDC event handler. The event is also
+ * generated for a transfer aborted by the device layer.
+ */
+static void WriteComplete(void) {
+    if (writeTransferCount == 0) {
+        return; // ignore transfers released by TransfersAborted
     }
+    const size_t numberOfBytes = writeTransferSizes[writeTransferOldest];
+    MaskedFifoReadPointerComplete(&writeFifo, numberOfBytes);
+    writeBytesInProgress -= numberOfBytes;
+    writeTransferOldest = (writeTransferOldest + 1) % USB_CDC_WRITE_TRANSFERS;
+    writeTransferCount--;
+}
+
+/**
+ * @brief Releases all transfers in progress. This function must only be called
+ * from the device event handler for the reset and deconfigured events. The
+ * device layer cancels all transfers and disables the endpoints before these
+ * events so the hardware no longer accesses the transfer data. Each cancelled
+ * transfer normally generates a complete event first and so there is
+ * normally nothing to release.
+ */
+static void TransfersAborted(void) {
+    readTransferCount = 0;
+    MaskedFifoReadPointerComplete(&writeFifo, writeBytesInProgress);
+    writeBytesInProgress = 0;
+    writeTransferCount = 0;
 }
 
 /**
@@ -217,7 +306,7 @@ bool UsbCdcPortOpen(void) {
  * @return Number of bytes available in the read buffer.
  */
 size_t UsbCdcAvailableRead(void) {
-    return FifoAvailableRead(&readFifo);
+    return MaskedFifoAvailableRead(&readFifo);
 }
 
 /**
@@ -227,7 +316,7 @@ size_t UsbCdcAvailableRead(void) {
  * @return Number of bytes read.
  */
 size_t UsbCdcRead(void* const destination, size_t numberOfBytes) {
-    return FifoRead(&readFifo, destination, numberOfBytes);
+    return MaskedFifoRead(&readFifo, destination, numberOfBytes);
 }
 
 /**
@@ -236,7 +325,36 @@ size_t UsbCdcRead(void* const destination, size_t numberOfBytes) {
  * @return Byte.
  */
 uint8_t UsbCdcReadByte(void) {
-    return FifoReadByte(&readFifo);
+    return MaskedFifoReadByte(&readFifo);
+}
+
+/**
+ * @brief Provides a pointer to the next contiguous block of data in the read
+ * buffer so that data can be read without an intermediate copy. The data may
+ * be modified in place. UsbCdcReadPointerComplete must be called after data
+ * has been read.
+ * @param pointer Pointer.
+ * @param numberOfBytes Number of bytes.
+ */
+void UsbCdcReadPointer(void* * const pointer, size_t * const numberOfBytes) {
+    MaskedFifoReadPointer(&readFifo, (volatile void**) pointer, numberOfBytes);
+}
+
+/**
+ * @brief Updates the read buffer after UsbCdcReadPointer.
+ * @param numberOfBytes Number of bytes.
+ */
+void UsbCdcReadPointerComplete(const size_t numberOfBytes) {
+    MaskedFifoReadPointerComplete(&readFifo, numberOfBytes);
+}
+
+/**
+ * @brief Returns the total number of received bytes discarded because the read
+ * buffer was full.
+ * @return Total number of received bytes discarded.
+ */
+uint32_t UsbCdcReadBufferOverflow(void) {
+    return readBufferOverflow;
 }
 
 /**
@@ -244,7 +362,7 @@ uint8_t UsbCdcReadByte(void) {
  * @return Space available in the write buffer.
  */
 size_t UsbCdcAvailableWrite(void) {
-    return FifoAvailableWrite(&writeFifo);
+    return MaskedFifoAvailableWrite(&writeFifo);
 }
 
 /**
@@ -254,7 +372,26 @@ size_t UsbCdcAvailableWrite(void) {
  * @return Result.
  */
 FifoResult UsbCdcWrite(const void* const data, const size_t numberOfBytes) {
-    return FifoWrite(&writeFifo, data, numberOfBytes);
+    return MaskedFifoWrite(&writeFifo, data, numberOfBytes);
+}
+
+/**
+ * @brief Provides a pointer to the next contiguous block of space in the write
+ * buffer so that data can be written without an intermediate copy.
+ * UsbCdcWritePointerComplete must be called after data has been written.
+ * @param pointer Pointer.
+ * @param numberOfBytes Number of bytes.
+ */
+void UsbCdcWritePointer(void* * const pointer, size_t * const numberOfBytes) {
+    MaskedFifoWritePointer(&writeFifo, (volatile void**) pointer, numberOfBytes);
+}
+
+/**
+ * @brief Updates the write buffer after UsbCdcWritePointer.
+ * @param numberOfBytes Number of bytes.
+ */
+void UsbCdcWritePointerComplete(const size_t numberOfBytes) {
+    MaskedFifoWritePointerComplete(&writeFifo, numberOfBytes);
 }
 
 /**
@@ -263,7 +400,7 @@ FifoResult UsbCdcWrite(const void* const data, const size_t numberOfBytes) {
  * @return Result.
  */
 FifoResult UsbCdcWriteByte(const uint8_t byte) {
-    return FifoWriteByte(&writeFifo, byte);
+    return MaskedFifoWriteByte(&writeFifo, byte);
 }
 
 //------------------------------------------------------------------------------
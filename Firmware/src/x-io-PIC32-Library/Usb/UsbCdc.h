@@ -25,8 +25,13 @@ bool UsbCdcPortOpen(void);
 size_t UsbCdcAvailableRead(void);
 size_t UsbCdcRead(void* const destination, size_t numberOfBytes);
 uint8_t UsbCdcReadByte(void);
+void UsbCdcReadPointer(void* * const pointer, size_t * const numberOfBytes);
+void UsbCdcReadPointerComplete(const size_t numberOfBytes);
+uint32_t UsbCdcReadBufferOverflow(void);
 size_t UsbCdcAvailableWrite(void);
 FifoResult UsbCdcWrite(const void* const data, const size_t numberOfBytes);
+void UsbCdcWritePointer(void* * const pointer, size_t * const numberOfBytes);
+void UsbCdcWritePointerComplete(const size_t numberOfBytes);
 FifoResult UsbCdcWriteByte(const uint8_t byte);
 
 #endif